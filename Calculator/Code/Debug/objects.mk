@@ -4,5 +4,5 @@
 
 USER_OBJS :=
 
-LIBS := -lprintf_flt
+LIBS :=
 
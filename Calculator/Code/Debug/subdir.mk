@@ -4,19 +4,43 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../bcd.c \
+../calc.c \
 ../calculator.c \
+../cordic.c \
+../eeprom_mirror.c \
+../expr.c \
+../fixed.c \
+../fmt.c \
 ../keypad.c \
-../lcd.c 
+../lcd.c \
+../lcd_queue.c 
 
 OBJS += \
+./bcd.o \
+./calc.o \
 ./calculator.o \
+./cordic.o \
+./eeprom_mirror.o \
+./expr.o \
+./fixed.o \
+./fmt.o \
 ./keypad.o \
-./lcd.o 
+./lcd.o \
+./lcd_queue.o 
 
 C_DEPS += \
+./bcd.d \
+./calc.d \
 ./calculator.d \
+./cordic.d \
+./eeprom_mirror.d \
+./expr.d \
+./fixed.d \
+./fmt.d \
 ./keypad.d \
-./lcd.d 
+./lcd.d \
+./lcd_queue.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
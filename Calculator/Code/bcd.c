@@ -0,0 +1,667 @@
+ /******************************************************************************
+ *
+ * [MODULE]: BCD
+ *
+ * [FILE NAME]: bcd.c
+ *
+ * [DESCRIPTION]: Source file for the packed BCD arithmetic
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include "bcd.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Quotient of a value 0 --> 1028 divided by 10 without a division */
+#define BCD_DIVIDE_BY_10(value)	((uint8)(((uint16)(value) * 205) >> 11))
+
+/* Digits of the quotient of the division: the integer and fraction digits and a rounding digit */
+#define BCD_QUOTIENT_DIGITS	(BCD_DIGITS + BCD_DECIMALS + 1)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Unpacked digits (least significant first) of the operands and the results */
+static uint8 g_a[BCD_DIGITS];
+static uint8 g_b[BCD_DIGITS + 1];
+static uint8 g_product[(2 * BCD_DIGITS) + 1];
+static uint8 g_remainder[BCD_DIGITS + 1];
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/* Function responsible for adding or subtracting (b is negated if negateB is TRUE) */
+static uint8 BCD_addSigned(const BCD_Type * a,const BCD_Type * b,uint8 negateB,BCD_Type * Result_Ptr);
+
+/* Function responsible for adding two packed magnitudes, returns the carry out */
+static uint8 BCD_addMagnitude(const uint8 *a,const uint8 *b,uint8 *result);
+
+/* Function responsible for subtracting two packed magnitudes (a >= b) */
+static void BCD_subMagnitude(const uint8 *a,const uint8 *b,uint8 *result);
+
+/* Function responsible for comparing two packed magnitudes, returns -1, 0 or 1 */
+static sint8 BCD_compareMagnitude(const uint8 *a,const uint8 *b);
+
+/* Function responsible for unpacking the digits of a number */
+static void BCD_unpack(const BCD_Type * Number_Ptr,uint8 *digits);
+
+/* Function responsible for packing digits in a number, returns FALSE if it saturates */
+static uint8 BCD_pack(const uint8 *digits,uint8 count,uint8 negative,BCD_Type * Result_Ptr);
+
+/* Function responsible for setting a number to the largest magnitude of a sign */
+static uint8 BCD_saturate(uint8 negative,BCD_Type * Result_Ptr);
+
+/* Function responsible for dividing a value by 10 with shifts and adds, returns the remainder */
+static uint8 BCD_divideBy10(uint32 *value);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: BCD_clear
+ *
+ * [Description]: Function to set a number to zero
+ *
+ * [Args]:	  Number_Ptr
+ *
+ * [in]		  None
+ *
+ * [out]	  Number_Ptr: Pointer to BCD_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void BCD_clear(BCD_Type * Number_Ptr)
+{
+	uint8 i;
+
+	for(i = 0; i < BCD_BYTES; i++)
+	{
+		Number_Ptr->digits[i] = 0;
+	}
+	Number_Ptr->negative = FALSE;
+}
+
+/*******************************************************************************
+ * [Function Name]: BCD_appendDigit
+ *
+ * [Description]: Function to add a digit to the right of the integer part of a
+ * 		  number without fraction (number * 10 + digit), as it is typed
+ *
+ * [Args]:	  Number_Ptr, digit
+ *
+ * [in]		  digit: Unsigned Character (0 --> 9)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  Number_Ptr: Pointer to BCD_Type
+ *
+ * [Returns]:     TRUE, or FALSE if the integer part is full (the number is not
+ * 		  changed)
+ *******************************************************************************/
+uint8 BCD_appendDigit(BCD_Type * Number_Ptr,uint8 digit)
+{
+	uint8 i;
+
+	if((Number_Ptr->digits[BCD_BYTES - 1] & 0xF0) != 0)
+	{
+		return FALSE;	/* The most significant digit is used */
+	}
+
+	/* Shift all the digits one place to the left, the fraction digits are zeros */
+	for(i = BCD_BYTES - 1; i > 0; i--)
+	{
+		Number_Ptr->digits[i] = (Number_Ptr->digits[i] << 4) | (Number_Ptr->digits[i - 1] >> 4);
+	}
+	Number_Ptr->digits[0] <<= 4;
+
+	/* The new digit is the units digit, the first one after the decimals */
+	Number_Ptr->digits[BCD_DECIMALS / 2] |= digit << (4 * (BCD_DECIMALS % 2));
+	return TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]: BCD_negate
+ *
+ * [Description]: Function to change the sign of a number
+ *
+ * [Args]:	  Number_Ptr
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  Number_Ptr: Pointer to BCD_Type
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void BCD_negate(BCD_Type * Number_Ptr)
+{
+	Number_Ptr->negative = (Number_Ptr->negative || BCD_isZero(Number_Ptr)) ? FALSE : TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]: BCD_isZero
+ *
+ * [Description]: Function to check if a number is zero
+ *
+ * [Args]:	  Number_Ptr
+ *
+ * [in]		  Number_Ptr: Pointer to BCD_Type
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the number is zero, FALSE otherwise
+ *******************************************************************************/
+uint8 BCD_isZero(const BCD_Type * Number_Ptr)
+{
+	uint8 i;
+
+	for(i = 0; i < BCD_BYTES; i++)
+	{
+		if(Number_Ptr->digits[i] != 0)
+		{
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]: BCD_add
+ *
+ * [Description]: Function to add two numbers (a + b), the result can be one of
+ * 		  the operands
+ *
+ * [Args]:	  a, b, Result_Ptr
+ *
+ * [in]		  a, b: Pointer to BCD_Type
+ *
+ * [out]	  Result_Ptr: Pointer to BCD_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated to the largest
+ * 		  number of its sign
+ *******************************************************************************/
+uint8 BCD_add(const BCD_Type * a,const BCD_Type * b,BCD_Type * Result_Ptr)
+{
+	return BCD_addSigned(a, b, FALSE, Result_Ptr);
+}
+
+/*******************************************************************************
+ * [Function Name]: BCD_sub
+ *
+ * [Description]: Function to subtract two numbers (a - b), the result can be
+ * 		  one of the operands
+ *
+ * [Args]:	  a, b, Result_Ptr
+ *
+ * [in]		  a, b: Pointer to BCD_Type
+ *
+ * [out]	  Result_Ptr: Pointer to BCD_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated to the largest
+ * 		  number of its sign
+ *******************************************************************************/
+uint8 BCD_sub(const BCD_Type * a,const BCD_Type * b,BCD_Type * Result_Ptr)
+{
+	return BCD_addSigned(a, b, TRUE, Result_Ptr);
+}
+
+/*******************************************************************************
+ * [Function Name]: BCD_mul
+ *
+ * [Description]: Function to multiply two numbers (a * b), rounded half away
+ * 		  from zero to BCD_DECIMALS decimals, the result can be one of
+ * 		  the operands
+ *
+ * [Args]:	  a, b, Result_Ptr
+ *
+ * [in]		  a, b: Pointer to BCD_Type
+ *
+ * [out]	  Result_Ptr: Pointer to BCD_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated to the largest
+ * 		  number of its sign
+ *******************************************************************************/
+uint8 BCD_mul(const BCD_Type * a,const BCD_Type * b,BCD_Type * Result_Ptr)
+{
+	uint8 negative = (a->negative != b->negative) ? TRUE : FALSE;
+	uint8 i;
+	uint8 j;
+	uint8 carry;
+	uint8 value;
+
+	BCD_unpack(a, g_a);
+	BCD_unpack(b, g_b);
+	for(i = 0; i < ((2 * BCD_DIGITS) + 1); i++)
+	{
+		g_product[i] = 0;
+	}
+
+	/* Long multiplication: one row of digit products per digit of (b), each below 100 */
+	for(i = 0; i < BCD_DIGITS; i++)
+	{
+		if(g_b[i] == 0)
+		{
+			continue;
+		}
+
+		carry = 0;
+		for(j = 0; j < BCD_DIGITS; j++)
+		{
+			value = g_product[i + j] + (g_a[j] * g_b[i]) + carry;
+			carry = BCD_DIVIDE_BY_10(value);
+			g_product[i + j] = value - (carry * 10);
+		}
+		g_product[i + BCD_DIGITS] = carry;
+	}
+
+	/* The product has twice the decimals, round the extra ones away */
+	if(g_product[BCD_DECIMALS - 1] >= 5)
+	{
+		for(i = BCD_DECIMALS; g_product[i] == 9; i++)
+		{
+			g_product[i] = 0;
+		}
+		g_product[i]++;
+	}
+
+	return BCD_pack(&g_product[BCD_DECIMALS], (2 * BCD_DIGITS) + 1 - BCD_DECIMALS, negative, Result_Ptr);
+}
+
+/*******************************************************************************
+ * [Function Name]: BCD_div
+ *
+ * [Description]: Function to divide two numbers (a / b), rounded half away
+ * 		  from zero to BCD_DECIMALS decimals, a division by zero
+ * 		  saturates to the sign of (a), the result can be one of the
+ * 		  operands
+ *
+ * [Args]:	  a, b, Result_Ptr
+ *
+ * [in]		  a, b: Pointer to BCD_Type
+ *
+ * [out]	  Result_Ptr: Pointer to BCD_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated to the largest
+ * 		  number of its sign
+ *******************************************************************************/
+uint8 BCD_div(const BCD_Type * a,const BCD_Type * b,BCD_Type * Result_Ptr)
+{
+	uint8 negative = (a->negative != b->negative) ? TRUE : FALSE;
+	uint8 *quotient = g_product;
+	uint8 k;
+	uint8 i;
+	uint8 q;
+	uint8 borrow;
+	sint8 difference;
+
+	if(BCD_isZero(b))
+	{
+		return BCD_saturate(a->negative, Result_Ptr);
+	}
+
+	BCD_unpack(a, g_a);
+	BCD_unpack(b, g_b);
+	g_b[BCD_DIGITS] = 0;
+	for(i = 0; i < (BCD_DIGITS + 1); i++)
+	{
+		g_remainder[i] = 0;
+	}
+
+	/*
+	 * Long division of (a) followed by BCD_DECIMALS + 1 zeros: each quotient digit is
+	 * the number of times (b) is subtracted from the remainder (9 at most)
+	 */
+	for(k = BCD_QUOTIENT_DIGITS; k > 0; k--)
+	{
+		/* Remainder = remainder * 10 + next digit of the dividend */
+		for(i = BCD_DIGITS; i > 0; i--)
+		{
+			g_remainder[i] = g_remainder[i - 1];
+		}
+		g_remainder[0] = (k > (BCD_DECIMALS + 1)) ? g_a[k - (BCD_DECIMALS + 2)] : 0;
+
+		q = 0;
+		while(1)
+		{
+			/* Compare the remainder with (b) from the most significant digit */
+			for(i = BCD_DIGITS; (i > 0) && (g_remainder[i] == g_b[i]); i--)
+			{
+			}
+			if(g_remainder[i] < g_b[i])
+			{
+				break;
+			}
+
+			borrow = 0;
+			for(i = 0; i < (BCD_DIGITS + 1); i++)
+			{
+				difference = g_remainder[i] - g_b[i] - borrow;
+				borrow = (difference < 0) ? 1 : 0;
+				g_remainder[i] = difference + (borrow * 10);
+			}
+			q++;
+		}
+		quotient[k - 1] = q;
+	}
+	quotient[BCD_QUOTIENT_DIGITS] = 0;
+
+	/* The last digit is only used to round */
+	if(quotient[0] >= 5)
+	{
+		for(i = 1; quotient[i] == 9; i++)
+		{
+			quotient[i] = 0;
+		}
+		quotient[i]++;
+	}
+
+	return BCD_pack(&quotient[1], BCD_QUOTIENT_DIGITS, negative, Result_Ptr);
+}
+
+/*******************************************************************************
+ * [Function Name]: BCD_toString
+ *
+ * [Description]: Function to write a number in decimal without the zeros before
+ * 		  its integer part and after its fraction
+ *
+ * [Args]:	  Str, Number_Ptr
+ *
+ * [in]		  Number_Ptr: Pointer to BCD_Type
+ *
+ * [out]	  Str: Pointer to character (buffer of BCD_TEXT_SIZE characters)
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     Number of characters written without the null terminator
+ *******************************************************************************/
+uint8 BCD_toString(char *Str,const BCD_Type * Number_Ptr)
+{
+	uint8 length = 0;
+	uint8 first = BCD_DIGITS - 1;	/* Most significant digit written */
+	uint8 last = 0;			/* Least significant digit written */
+	uint8 i;
+
+	BCD_unpack(Number_Ptr, g_a);
+
+	while((first > BCD_DECIMALS) && (g_a[first] == 0))
+	{
+		first--;	/* The units digit is always written */
+	}
+	while((last < BCD_DECIMALS) && (g_a[last] == 0))
+	{
+		last++;
+	}
+
+	if(Number_Ptr->negative)
+	{
+		Str[length++] = '-';
+	}
+
+	/* The digits are already decimal, each one is written as its character */
+	for(i = first + 1; i > last; i--)
+	{
+		if(i == BCD_DECIMALS)
+		{
+			Str[length++] = '.';
+		}
+		Str[length++] = '0' + g_a[i - 1];
+	}
+	Str[length] = '\0';
+	return length;
+}
+
+/*******************************************************************************
+ * [Function Name]: BCD_toScaled
+ *
+ * [Description]: Function to convert a number to a signed long multiplied by
+ * 		  10^BCD_DECIMALS (decimal fixed point)
+ *
+ * [Args]:	  Number_Ptr, Value_Ptr
+ *
+ * [in]		  Number_Ptr: Pointer to BCD_Type
+ *
+ * [out]	  Value_Ptr: Pointer to Signed Long
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the number does not fit in a signed long
+ * 		  (the value is not changed)
+ *******************************************************************************/
+uint8 BCD_toScaled(const BCD_Type * Number_Ptr,sint32 * Value_Ptr)
+{
+	uint32 magnitude = 0;
+	uint8 i;
+
+	BCD_unpack(Number_Ptr, g_a);
+
+	for(i = BCD_DIGITS; i > 0; i--)
+	{
+		/* The most negative signed long is not needed, so the limit is 0x7FFFFFFF for both signs */
+		if((magnitude > (0x7FFFFFFFUL / 10)) || ((magnitude == (0x7FFFFFFFUL / 10)) && (g_a[i - 1] > 7)))
+		{
+			return FALSE;
+		}
+		magnitude = (magnitude << 3) + (magnitude << 1) + g_a[i - 1];	/* magnitude * 10 + digit */
+	}
+
+	*Value_Ptr = Number_Ptr->negative ? -(sint32)magnitude : (sint32)magnitude;
+	return TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]: BCD_fromScaled
+ *
+ * [Description]: Function to convert a signed long multiplied by 10^BCD_DECIMALS
+ * 		  (decimal fixed point) to a number
+ *
+ * [Args]:	  value, Result_Ptr
+ *
+ * [in]		  value: Signed Long (the number multiplied by 10^BCD_DECIMALS)
+ *
+ * [out]	  Result_Ptr: Pointer to BCD_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated to the largest
+ * 		  number of its sign
+ *******************************************************************************/
+uint8 BCD_fromScaled(sint32 value,BCD_Type * Result_Ptr)
+{
+	uint32 magnitude = (value < 0) ? ((uint32)0 - (uint32)value) : (uint32)value;
+	uint8 i;
+
+	/* The scaled value has the same digits as the number, least significant first */
+	for(i = 0; i < BCD_DIGITS; i++)
+	{
+		g_a[i] = (magnitude != 0) ? BCD_divideBy10(&magnitude) : 0;
+	}
+	if(magnitude != 0)
+	{
+		return BCD_saturate((value < 0), Result_Ptr);
+	}
+	return BCD_pack(g_a, BCD_DIGITS, (value < 0), Result_Ptr);
+}
+
+static uint8 BCD_addSigned(const BCD_Type * a,const BCD_Type * b,uint8 negateB,BCD_Type * Result_Ptr)
+{
+	uint8 negativeB = (b->negative != negateB) ? TRUE : FALSE;
+	uint8 negative;
+
+	if(a->negative == negativeB)
+	{
+		/* Same signs: add the magnitudes */
+		negative = a->negative;
+		if(BCD_addMagnitude(a->digits, b->digits, Result_Ptr->digits))
+		{
+			return BCD_saturate(negative, Result_Ptr);
+		}
+	}
+	else if(BCD_compareMagnitude(a->digits, b->digits) >= 0)
+	{
+		/* Different signs: subtract the smaller magnitude, the result has the sign of the larger one */
+		negative = a->negative;
+		BCD_subMagnitude(a->digits, b->digits, Result_Ptr->digits);
+	}
+	else
+	{
+		negative = negativeB;
+		BCD_subMagnitude(b->digits, a->digits, Result_Ptr->digits);
+	}
+
+	Result_Ptr->negative = negative;
+	if(BCD_isZero(Result_Ptr))
+	{
+		Result_Ptr->negative = FALSE;
+	}
+	return TRUE;
+}
+
+static uint8 BCD_addMagnitude(const uint8 *a,const uint8 *b,uint8 *result)
+{
+	uint8 carry = 0;
+	uint8 low;
+	uint8 high;
+	uint8 i;
+
+	/* Each byte is read before the result byte is written, so the result can be an operand */
+	for(i = 0; i < BCD_BYTES; i++)
+	{
+		low = (a[i] & 0x0F) + (b[i] & 0x0F) + carry;
+		carry = (low > 9) ? 1 : 0;
+		low -= carry * 10;
+
+		high = (a[i] >> 4) + (b[i] >> 4) + carry;
+		carry = (high > 9) ? 1 : 0;
+		high -= carry * 10;
+
+		result[i] = (high << 4) | low;
+	}
+	return carry;
+}
+
+static void BCD_subMagnitude(const uint8 *a,const uint8 *b,uint8 *result)
+{
+	uint8 borrow = 0;
+	sint8 low;
+	sint8 high;
+	uint8 i;
+
+	for(i = 0; i < BCD_BYTES; i++)
+	{
+		low = (sint8)(a[i] & 0x0F) - (sint8)(b[i] & 0x0F) - borrow;
+		borrow = (low < 0) ? 1 : 0;
+		low += borrow * 10;
+
+		high = (sint8)(a[i] >> 4) - (sint8)(b[i] >> 4) - borrow;
+		borrow = (high < 0) ? 1 : 0;
+		high += borrow * 10;
+
+		result[i] = ((uint8)high << 4) | (uint8)low;
+	}
+}
+
+static sint8 BCD_compareMagnitude(const uint8 *a,const uint8 *b)
+{
+	uint8 i;
+
+	/* A packed byte compares as its two digits, the high nibble is the more significant */
+	for(i = BCD_BYTES; i > 0; i--)
+	{
+		if(a[i - 1] != b[i - 1])
+		{
+			return (a[i - 1] > b[i - 1]) ? 1 : -1;
+		}
+	}
+	return 0;
+}
+
+static void BCD_unpack(const BCD_Type * Number_Ptr,uint8 *digits)
+{
+	uint8 i;
+
+	for(i = 0; i < BCD_BYTES; i++)
+	{
+		digits[2 * i] = Number_Ptr->digits[i] & 0x0F;
+		digits[(2 * i) + 1] = Number_Ptr->digits[i] >> 4;
+	}
+}
+
+static uint8 BCD_pack(const uint8 *digits,uint8 count,uint8 negative,BCD_Type * Result_Ptr)
+{
+	uint8 i;
+
+	/* The digits above BCD_DIGITS must be zeros */
+	for(i = BCD_DIGITS; i < count; i++)
+	{
+		if(digits[i] != 0)
+		{
+			return BCD_saturate(negative, Result_Ptr);
+		}
+	}
+
+	for(i = 0; i < BCD_BYTES; i++)
+	{
+		Result_Ptr->digits[i] = (digits[(2 * i) + 1] << 4) | digits[2 * i];
+	}
+	Result_Ptr->negative = (negative && !BCD_isZero(Result_Ptr)) ? TRUE : FALSE;
+	return TRUE;
+}
+
+static uint8 BCD_saturate(uint8 negative,BCD_Type * Result_Ptr)
+{
+	uint8 i;
+
+	for(i = 0; i < BCD_BYTES; i++)
+	{
+		Result_Ptr->digits[i] = 0x99;
+	}
+	Result_Ptr->negative = negative;
+	return FALSE;
+}
+
+static uint8 BCD_divideBy10(uint32 *value)
+{
+	uint32 n = *value;
+	uint32 q;
+	uint8 r;
+
+	/*
+	 * Approximate n * 0.8 with shifts and adds and divide by 8, the result is either
+	 * exact or one less than the quotient so it is corrected once
+	 */
+	q = (n >> 1) + (n >> 2);
+	q += (q >> 4);
+	q += (q >> 8);
+	q += (q >> 16);
+	q >>= 3;
+
+	r = (uint8)(n - ((q << 3) + (q << 1)));	/* n - q*10 */
+	if(r > 9)
+	{
+		q++;
+		r -= 10;
+	}
+
+	*value = q;
+	return r;
+}
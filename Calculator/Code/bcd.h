@@ -0,0 +1,268 @@
+ /******************************************************************************
+ *
+ * [MODULE]: BCD
+ *
+ * [FILE NAME]: bcd.h
+ *
+ * [DESCRIPTION]: Header file for the packed BCD arithmetic, a number is stored
+ * 		  as BCD_DIGITS decimal digits (2 digits per byte) with a fixed
+ * 		  number of decimals and a sign, the operations work digit by
+ * 		  digit so their time depends only on the number of digits and
+ * 		  the numbers are written as text without any conversion from
+ * 		  binary to decimal
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef BCD_H_
+#define BCD_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/*
+ * Digits of a number (must be even) and the digits of them after the decimal
+ * point, 14 digits with 3 decimals: +/-99999999999.999
+ */
+#define BCD_DIGITS		14
+#define BCD_DECIMALS		3
+#define BCD_BYTES		(BCD_DIGITS / 2)
+
+#if ((BCD_DIGITS % 2) != 0) || (BCD_DECIMALS >= BCD_DIGITS)
+#error "BCD_DIGITS must be even and greater than BCD_DECIMALS"
+#endif
+
+/*
+ * Work of each operation, bounded by the number of digits whatever the values:
+ * add/sub: BCD_BYTES byte steps
+ * mul: BCD_DIGITS * BCD_DIGITS digit products at most (zero digits are skipped)
+ * div: 10 * (BCD_DIGITS + BCD_DECIMALS + 1) compare/subtract passes of BCD_DIGITS + 1 digits at most
+ */
+
+/* Size of the text of a number: sign + digits + decimal point + null terminator */
+#define BCD_TEXT_SIZE		(BCD_DIGITS + 3)
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	uint8 digits[BCD_BYTES];	/* Least significant digits first, low nibble first */
+	uint8 negative;			/* Always FALSE for zero */
+}BCD_Type;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: BCD_clear
+ *
+ * [Description]: Function to set a number to zero
+ *
+ * [Args]:	  Number_Ptr
+ *
+ * [in]		  None
+ *
+ * [out]	  Number_Ptr: Pointer to BCD_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void BCD_clear(BCD_Type * Number_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: BCD_appendDigit
+ *
+ * [Description]: Function to add a digit to the right of the integer part of a
+ * 		  number without fraction (number * 10 + digit), as it is typed
+ *
+ * [Args]:	  Number_Ptr, digit
+ *
+ * [in]		  digit: Unsigned Character (0 --> 9)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  Number_Ptr: Pointer to BCD_Type
+ *
+ * [Returns]:     TRUE, or FALSE if the integer part is full (the number is not
+ * 		  changed)
+ *******************************************************************************/
+uint8 BCD_appendDigit(BCD_Type * Number_Ptr,uint8 digit);
+
+/*******************************************************************************
+ * [Function Name]: BCD_negate
+ *
+ * [Description]: Function to change the sign of a number
+ *
+ * [Args]:	  Number_Ptr
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  Number_Ptr: Pointer to BCD_Type
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void BCD_negate(BCD_Type * Number_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: BCD_isZero
+ *
+ * [Description]: Function to check if a number is zero
+ *
+ * [Args]:	  Number_Ptr
+ *
+ * [in]		  Number_Ptr: Pointer to BCD_Type
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the number is zero, FALSE otherwise
+ *******************************************************************************/
+uint8 BCD_isZero(const BCD_Type * Number_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: BCD_add
+ *
+ * [Description]: Function to add two numbers (a + b), the result can be one of
+ * 		  the operands
+ *
+ * [Args]:	  a, b, Result_Ptr
+ *
+ * [in]		  a, b: Pointer to BCD_Type
+ *
+ * [out]	  Result_Ptr: Pointer to BCD_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated to the largest
+ * 		  number of its sign
+ *******************************************************************************/
+uint8 BCD_add(const BCD_Type * a,const BCD_Type * b,BCD_Type * Result_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: BCD_sub
+ *
+ * [Description]: Function to subtract two numbers (a - b), the result can be
+ * 		  one of the operands
+ *
+ * [Args]:	  a, b, Result_Ptr
+ *
+ * [in]		  a, b: Pointer to BCD_Type
+ *
+ * [out]	  Result_Ptr: Pointer to BCD_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated to the largest
+ * 		  number of its sign
+ *******************************************************************************/
+uint8 BCD_sub(const BCD_Type * a,const BCD_Type * b,BCD_Type * Result_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: BCD_mul
+ *
+ * [Description]: Function to multiply two numbers (a * b), rounded half away
+ * 		  from zero to BCD_DECIMALS decimals, the result can be one of
+ * 		  the operands
+ *
+ * [Args]:	  a, b, Result_Ptr
+ *
+ * [in]		  a, b: Pointer to BCD_Type
+ *
+ * [out]	  Result_Ptr: Pointer to BCD_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated to the largest
+ * 		  number of its sign
+ *******************************************************************************/
+uint8 BCD_mul(const BCD_Type * a,const BCD_Type * b,BCD_Type * Result_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: BCD_div
+ *
+ * [Description]: Function to divide two numbers (a / b), rounded half away
+ * 		  from zero to BCD_DECIMALS decimals, a division by zero
+ * 		  saturates to the sign of (a), the result can be one of the
+ * 		  operands
+ *
+ * [Args]:	  a, b, Result_Ptr
+ *
+ * [in]		  a, b: Pointer to BCD_Type
+ *
+ * [out]	  Result_Ptr: Pointer to BCD_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated to the largest
+ * 		  number of its sign
+ *******************************************************************************/
+uint8 BCD_div(const BCD_Type * a,const BCD_Type * b,BCD_Type * Result_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: BCD_toString
+ *
+ * [Description]: Function to write a number in decimal without the zeros before
+ * 		  its integer part and after its fraction
+ *
+ * [Args]:	  Str, Number_Ptr
+ *
+ * [in]		  Number_Ptr: Pointer to BCD_Type
+ *
+ * [out]	  Str: Pointer to character (buffer of BCD_TEXT_SIZE characters)
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     Number of characters written without the null terminator
+ *******************************************************************************/
+uint8 BCD_toString(char *Str,const BCD_Type * Number_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: BCD_toScaled
+ *
+ * [Description]: Function to convert a number to a signed long multiplied by
+ * 		  10^BCD_DECIMALS (decimal fixed point)
+ *
+ * [Args]:	  Number_Ptr, Value_Ptr
+ *
+ * [in]		  Number_Ptr: Pointer to BCD_Type
+ *
+ * [out]	  Value_Ptr: Pointer to Signed Long
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the number does not fit in a signed long
+ * 		  (the value is not changed)
+ *******************************************************************************/
+uint8 BCD_toScaled(const BCD_Type * Number_Ptr,sint32 * Value_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: BCD_fromScaled
+ *
+ * [Description]: Function to convert a signed long multiplied by 10^BCD_DECIMALS
+ * 		  (decimal fixed point) to a number
+ *
+ * [Args]:	  value, Result_Ptr
+ *
+ * [in]		  value: Signed Long (the number multiplied by 10^BCD_DECIMALS)
+ *
+ * [out]	  Result_Ptr: Pointer to BCD_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated to the largest
+ * 		  number of its sign
+ *******************************************************************************/
+uint8 BCD_fromScaled(sint32 value,BCD_Type * Result_Ptr);
+
+#endif /* BCD_H_ */
@@ -0,0 +1,486 @@
+ /******************************************************************************
+ *
+ * [MODULE]: CALCULATOR
+ *
+ * [FILE NAME]: calc.c
+ *
+ * [DESCRIPTION]: Source file for the calculator core
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include "calc.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Characters kept on the expression row when the expression wraps */
+#define CALC_LINE_KEPT		(CALC_LINE_WIDTH / 2)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Function writing the text on the display */
+static void(*g_display_Ptr)(uint8 row,uint8 col,const char *Str);
+
+/* Memory register and history, and the function saving their changed bytes */
+static CALC_StoreType *g_store_Ptr;
+static void(*g_save_Ptr)(uint16 offset,uint16 size);
+
+/* Characters of the expression displayed on its row */
+static char g_line[CALC_LINE_WIDTH + 1];
+static uint8 g_lineLength = 0;
+
+/* Characters displayed on the result row */
+static uint8 g_resultLength = 0;
+
+/* The result of the last expression is displayed, and it is a number (not an error) */
+static uint8 g_showResult = FALSE;
+static uint8 g_resultValid = FALSE;
+static EXPR_NumberType g_result;
+
+static const char g_spaces[CALC_LINE_WIDTH + 1] = "                ";
+
+/* Names of the functions on the expression row, in the order of EXPR_FunctionType */
+static const char * const g_functionNames[] = {"SQRT(", "SIN(", "COS(", "ATAN(", "LOG2(", "EXP2("};
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/* Function responsible for calculating the expression and displaying its result */
+static void CALC_evaluate(void);
+
+/* Function responsible for displaying the result or the error of a calculation */
+static void CALC_showStatus(EXPR_StatusType status);
+
+/* Function responsible for adding characters at the end of the expression row */
+static void CALC_append(const char *Str);
+
+/* Function responsible for redrawing the expression row with its last characters when it is full */
+static void CALC_wrap(void);
+
+/* Function responsible for displaying a text on the result row */
+static void CALC_showResult(const char *Str);
+
+/* Function responsible for clearing both rows and starting a new expression */
+static void CALC_clear(void);
+
+/* Function responsible for adding the result to the history */
+static void CALC_remember(void);
+
+/* Function responsible for saving bytes of the store that changed */
+static void CALC_save(const void *Field_Ptr,uint16 size);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: CALC_init
+ *
+ * [Description]: Function to start the calculator with an empty display, the
+ * 		  store is started empty if it is not valid (CALC_STORE_MAGIC)
+ *
+ * [Args]:	  a_displayPtr, Store_Ptr, a_savePtr
+ *
+ * [in]		  a_displayPtr: Pointer to function (writes a text at a row and a
+ * 				column of the calculator display)
+ * 		  a_savePtr: Pointer to function (called with the offset and the
+ * 			     size of the bytes of the store that changed, it must
+ * 			     return at once)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  Store_Ptr: Pointer to CALC_StoreType (memory register and
+ * 			     history kept by the application)
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void CALC_init(void(*a_displayPtr)(uint8 row,uint8 col,const char *Str),CALC_StoreType * Store_Ptr,void(*a_savePtr)(uint16 offset,uint16 size))
+{
+	g_display_Ptr = a_displayPtr;
+	g_store_Ptr = Store_Ptr;
+	g_save_Ptr = a_savePtr;
+	g_lineLength = CALC_LINE_WIDTH;		/* The display content is unknown, clear both rows */
+	g_resultLength = CALC_LINE_WIDTH;
+	CALC_clear();
+
+	/* A store never written (or of another version) starts empty */
+	if((Store_Ptr->magic != CALC_STORE_MAGIC) || (Store_Ptr->newest >= CALC_HISTORY_SIZE) ||
+	   (Store_Ptr->count > CALC_HISTORY_SIZE))
+	{
+		Store_Ptr->magic = CALC_STORE_MAGIC;
+		Store_Ptr->newest = CALC_HISTORY_SIZE - 1;	/* The first result goes to index 0 */
+		Store_Ptr->count = 0;
+		EXPR_clear(&Store_Ptr->memory);
+		CALC_save(Store_Ptr, sizeof(CALC_StoreType));
+	}
+}
+
+/*******************************************************************************
+ * [Function Name]: CALC_key
+ *
+ * [Description]: Function to process one key, only the changed characters of
+ * 		  the display are written
+ *
+ * [Args]:	  key
+ *
+ * [in]		  key: Unsigned Character (digit, operator, CALC_KEY_POWER,
+ * 		       CALC_KEY_EQUAL or CALC_KEY_CLEAR, other keys are ignored)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void CALC_key(uint8 key)
+{
+	char text[EXPR_TEXT_SIZE];
+	uint8 isDigit = (key <= 9) ? TRUE : FALSE;
+	EXPR_StatusType status;
+
+	if(key == CALC_KEY_CLEAR)
+	{
+		CALC_clear();
+		return;
+	}
+
+	if(key == CALC_KEY_EQUAL)
+	{
+		if(!g_showResult)
+		{
+			CALC_evaluate();	/* Otherwise the result is already displayed */
+		}
+		return;
+	}
+
+	if((!isDigit) && (key != '+') && (key != '-') && (key != '*') && (key != '/') && (key != CALC_KEY_POWER))
+	{
+		return;
+	}
+
+	if(g_showResult)
+	{
+		/* Start a new expression, it begins with the last result if the key is an operator */
+		CALC_clear();
+		if(g_resultValid && (!isDigit))
+		{
+			EXPR_number(&g_result);
+			EXPR_format(text, &g_result);
+			CALC_append(text);
+		}
+	}
+
+	if(isDigit)
+	{
+		status = EXPR_digit(key);
+		text[0] = '0' + key;
+	}
+	else
+	{
+		status = EXPR_operator(key);
+		text[0] = key;
+	}
+
+	if(status == EXPR_OK)
+	{
+		text[1] = '\0';
+		CALC_append(text);
+	}
+}
+
+/*******************************************************************************
+ * [Function Name]: CALC_function
+ *
+ * [Description]: Function to calculate a scientific function of the current
+ * 		  expression (or of the displayed result), the expression row
+ * 		  shows the function of the number and the result row its value
+ *
+ * [Args]:	  function
+ *
+ * [in]		  function: EXPR_FunctionType
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void CALC_function(EXPR_FunctionType function)
+{
+	char text[EXPR_TEXT_SIZE];
+	EXPR_NumberType value;
+	EXPR_StatusType status;
+
+	if(g_showResult)
+	{
+		if(!g_resultValid)
+		{
+			return;		/* An error is displayed, there is no number */
+		}
+		value = g_result;
+	}
+	else
+	{
+		status = EXPR_evaluate(&value);
+		if(status != EXPR_OK)
+		{
+			CALC_showStatus(status);
+			return;
+		}
+	}
+
+	/* The expression row shows the function of the number, like NAME(number) */
+	CALC_clear();
+	CALC_append(g_functionNames[function]);
+	EXPR_format(text, &value);
+	CALC_append(text);
+	CALC_append(")");
+
+	CALC_showStatus(EXPR_function(function, &value, &g_result));
+}
+
+/*******************************************************************************
+ * [Function Name]: CALC_memory
+ *
+ * [Description]: Function to add or subtract the current expression (or the
+ * 		  displayed result) to the memory register, the expression is
+ * 		  calculated and displayed like with '=', or to clear the
+ * 		  memory register
+ *
+ * [Args]:	  operation
+ *
+ * [in]		  operation: CALC_MemoryType
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void CALC_memory(CALC_MemoryType operation)
+{
+	EXPR_StatusType status;
+
+	if(operation == CALC_MEMORY_CLEAR)
+	{
+		EXPR_clear(&g_store_Ptr->memory);
+		CALC_save(&g_store_Ptr->memory, sizeof(EXPR_NumberType));
+		return;
+	}
+
+	if(!g_showResult)
+	{
+		CALC_evaluate();
+	}
+	if(!g_resultValid)
+	{
+		return;		/* An error is displayed, there is no number */
+	}
+
+	/* The memory register is kept if the sum overflows */
+	status = EXPR_calculate((operation == CALC_MEMORY_ADD) ? '+' : '-', &g_store_Ptr->memory, &g_result, &g_store_Ptr->memory);
+	if(status == EXPR_OK)
+	{
+		CALC_save(&g_store_Ptr->memory, sizeof(EXPR_NumberType));
+	}
+	else
+	{
+		CALC_showResult("=MEMORY OVERFLOW");
+		g_resultValid = FALSE;
+	}
+}
+
+/*******************************************************************************
+ * [Function Name]: CALC_recall
+ *
+ * [Description]: Function to enter the memory register or a result of the
+ * 		  history as the next number of the expression, nothing is done
+ * 		  if a number can not be entered here
+ *
+ * [Args]:	  index
+ *
+ * [in]		  index: Unsigned Character (0 for the memory register, 1 for
+ * 			 the last result --> CALC_HISTORY_SIZE for the oldest)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void CALC_recall(uint8 index)
+{
+	char text[EXPR_TEXT_SIZE];
+	const EXPR_NumberType *value_Ptr;
+	uint8 slot;
+
+	if(index == 0)
+	{
+		value_Ptr = &g_store_Ptr->memory;
+	}
+	else if(index <= g_store_Ptr->count)
+	{
+		/* Counted back from the newest result, around the end of the ring */
+		slot = g_store_Ptr->newest + (CALC_HISTORY_SIZE + 1) - index;
+		if(slot >= CALC_HISTORY_SIZE)
+		{
+			slot -= CALC_HISTORY_SIZE;
+		}
+		value_Ptr = &g_store_Ptr->history[slot];
+	}
+	else
+	{
+		return;		/* No result there yet */
+	}
+
+	if(g_showResult)
+	{
+		CALC_clear();	/* The number starts a new expression */
+	}
+
+	if(EXPR_number(value_Ptr) == EXPR_OK)
+	{
+		EXPR_format(text, value_Ptr);
+		CALC_append(text);
+	}
+}
+
+static void CALC_evaluate(void)
+{
+	CALC_showStatus(EXPR_evaluate(&g_result));
+}
+
+static void CALC_showStatus(EXPR_StatusType status)
+{
+	char text[EXPR_TEXT_SIZE + 1];
+	uint8 length;
+
+	switch(status)
+	{
+	case EXPR_OK:
+		/* The '=' is not displayed if the result takes the whole row */
+		text[0] = '=';
+		length = EXPR_format(text + 1, &g_result);
+		CALC_showResult((length < CALC_LINE_WIDTH) ? text : (text + 1));
+		break;
+	case EXPR_ERROR_DIVIDE_BY_ZERO:
+		CALC_showResult("=DIVIDE BY ZERO");
+		break;
+	case EXPR_ERROR_OVERFLOW:
+		CALC_showResult("=OVERFLOW");
+		break;
+	case EXPR_ERROR_MATH:
+		CALC_showResult("=MATH ERROR");
+		break;
+	default:
+		CALC_showResult("=SYNTAX ERROR");
+		break;
+	}
+
+	g_showResult = TRUE;	/* The next key starts a new expression */
+	g_resultValid = (status == EXPR_OK) ? TRUE : FALSE;
+	if(g_resultValid)
+	{
+		CALC_remember();
+	}
+}
+
+static void CALC_append(const char *Str)
+{
+	uint8 col = g_lineLength;	/* First new character */
+
+	for(; *Str != '\0'; Str++)
+	{
+		if(g_lineLength == CALC_LINE_WIDTH)
+		{
+			CALC_wrap();
+			col = g_lineLength;
+		}
+		g_line[g_lineLength] = *Str;
+		g_lineLength++;
+	}
+
+	/* Only the new characters are written */
+	g_line[g_lineLength] = '\0';
+	g_display_Ptr(CALC_ROW_EXPRESSION, col, &g_line[col]);
+}
+
+static void CALC_wrap(void)
+{
+	uint8 i;
+
+	/* Keep the last CALC_LINE_KEPT characters at the start of the row and clear the rest */
+	for(i = 0; i < CALC_LINE_WIDTH; i++)
+	{
+		g_line[i] = (i < CALC_LINE_KEPT) ? g_line[i + (CALC_LINE_WIDTH - CALC_LINE_KEPT)] : ' ';
+	}
+	g_line[CALC_LINE_WIDTH] = '\0';
+	g_display_Ptr(CALC_ROW_EXPRESSION, 0, g_line);
+	g_lineLength = CALC_LINE_KEPT;
+}
+
+static void CALC_showResult(const char *Str)
+{
+	uint8 length = 0;
+
+	while(Str[length] != '\0')
+	{
+		length++;
+	}
+	g_display_Ptr(CALC_ROW_RESULT, 0, Str);
+
+	/* Spaces over the rest of a longer text displayed before */
+	if(g_resultLength > length)
+	{
+		g_display_Ptr(CALC_ROW_RESULT, length, &g_spaces[CALC_LINE_WIDTH - (g_resultLength - length)]);
+	}
+	g_resultLength = length;
+}
+
+static void CALC_clear(void)
+{
+	/* Write spaces only over the used characters */
+	if(g_lineLength > 0)
+	{
+		g_display_Ptr(CALC_ROW_EXPRESSION, 0, &g_spaces[CALC_LINE_WIDTH - g_lineLength]);
+	}
+	if(g_resultLength > 0)
+	{
+		g_display_Ptr(CALC_ROW_RESULT, 0, &g_spaces[CALC_LINE_WIDTH - g_resultLength]);
+	}
+	g_lineLength = 0;
+	g_resultLength = 0;
+	g_showResult = FALSE;
+	EXPR_init();
+}
+
+static void CALC_remember(void)
+{
+	uint8 newest = g_store_Ptr->newest + 1;
+
+	/* The oldest result is replaced when the history is full */
+	if(newest == CALC_HISTORY_SIZE)
+	{
+		newest = 0;
+	}
+	g_store_Ptr->history[newest] = g_result;
+	g_store_Ptr->newest = newest;
+	if(g_store_Ptr->count < CALC_HISTORY_SIZE)
+	{
+		g_store_Ptr->count++;
+	}
+
+	CALC_save(&g_store_Ptr->history[newest], sizeof(EXPR_NumberType));
+	CALC_save(&g_store_Ptr->newest, 2);	/* newest and count */
+}
+
+static void CALC_save(const void *Field_Ptr,uint16 size)
+{
+	g_save_Ptr((uint16)((const uint8 *)Field_Ptr - (const uint8 *)g_store_Ptr), size);
+}
@@ -0,0 +1,174 @@
+ /******************************************************************************
+ *
+ * [MODULE]: CALCULATOR
+ *
+ * [FILE NAME]: calc.h
+ *
+ * [DESCRIPTION]: Header file for the calculator core, it takes the keys one by
+ * 		  one, feeds them to the expression engine and gives the text to
+ * 		  display on its two rows (expression and result) through a call
+ * 		  back function, so it uses no hardware and also builds on a PC,
+ * 		  the memory register and the history of the results are kept in
+ * 		  a store given by the application that saves its changes
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef CALC_H_
+#define CALC_H_
+
+#include "std_types.h"
+#include "expr.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Rows of the calculator display and their width */
+#define CALC_ROW_EXPRESSION	0	/* Expression being entered */
+#define CALC_ROW_RESULT		1	/* Result or error of the last expression */
+#define CALC_ROWS		2
+#define CALC_LINE_WIDTH		16
+
+/* Keys other than the digits 0 --> 9 and the operators '+', '-', '*', '/' */
+#define CALC_KEY_EQUAL		'='
+#define CALC_KEY_CLEAR		13
+#define CALC_KEY_POWER		EXPR_POWER	/* Integer power operator */
+
+/* Results kept in the history, recalled by CALC_recall 1 --> CALC_HISTORY_SIZE */
+#define CALC_HISTORY_SIZE	8
+
+/* First byte of a valid store, change it when CALC_StoreType changes */
+#define CALC_STORE_MAGIC	0xC1
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* Operations of the memory register */
+typedef enum
+{
+	CALC_MEMORY_ADD, CALC_MEMORY_SUBTRACT, CALC_MEMORY_CLEAR
+}CALC_MemoryType;
+
+/*
+ * Memory register and history of the results, the application keeps it (in the
+ * EEPROM for example) and it is read directly, a result changes one number of the
+ * history and the newest/count bytes, so only these bytes are saved
+ */
+typedef struct
+{
+	uint8 magic;		/* CALC_STORE_MAGIC */
+	uint8 newest;		/* Index of the last result in the history */
+	uint8 count;		/* Results in the history */
+	EXPR_NumberType memory;
+	EXPR_NumberType history[CALC_HISTORY_SIZE];
+}CALC_StoreType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: CALC_init
+ *
+ * [Description]: Function to start the calculator with an empty display, the
+ * 		  store is started empty if it is not valid (CALC_STORE_MAGIC)
+ *
+ * [Args]:	  a_displayPtr, Store_Ptr, a_savePtr
+ *
+ * [in]		  a_displayPtr: Pointer to function (writes a text at a row and a
+ * 				column of the calculator display)
+ * 		  a_savePtr: Pointer to function (called with the offset and the
+ * 			     size of the bytes of the store that changed, it must
+ * 			     return at once)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  Store_Ptr: Pointer to CALC_StoreType (memory register and
+ * 			     history kept by the application)
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void CALC_init(void(*a_displayPtr)(uint8 row,uint8 col,const char *Str),CALC_StoreType * Store_Ptr,void(*a_savePtr)(uint16 offset,uint16 size));
+
+/*******************************************************************************
+ * [Function Name]: CALC_key
+ *
+ * [Description]: Function to process one key, only the changed characters of
+ * 		  the display are written
+ *
+ * [Args]:	  key
+ *
+ * [in]		  key: Unsigned Character (digit, operator, CALC_KEY_POWER,
+ * 		       CALC_KEY_EQUAL or CALC_KEY_CLEAR, other keys are ignored)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void CALC_key(uint8 key);
+
+/*******************************************************************************
+ * [Function Name]: CALC_function
+ *
+ * [Description]: Function to calculate a scientific function of the current
+ * 		  expression (or of the displayed result), the expression row
+ * 		  shows the function of the number and the result row its value
+ *
+ * [Args]:	  function
+ *
+ * [in]		  function: EXPR_FunctionType
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void CALC_function(EXPR_FunctionType function);
+
+/*******************************************************************************
+ * [Function Name]: CALC_memory
+ *
+ * [Description]: Function to add or subtract the current expression (or the
+ * 		  displayed result) to the memory register, the expression is
+ * 		  calculated and displayed like with '=', or to clear the
+ * 		  memory register
+ *
+ * [Args]:	  operation
+ *
+ * [in]		  operation: CALC_MemoryType
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void CALC_memory(CALC_MemoryType operation);
+
+/*******************************************************************************
+ * [Function Name]: CALC_recall
+ *
+ * [Description]: Function to enter the memory register or a result of the
+ * 		  history as the next number of the expression, nothing is done
+ * 		  if a number can not be entered here
+ *
+ * [Args]:	  index
+ *
+ * [in]		  index: Unsigned Character (0 for the memory register, 1 for
+ * 			 the last result --> CALC_HISTORY_SIZE for the oldest)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void CALC_recall(uint8 index);
+
+#endif /* CALC_H_ */
@@ -9,7 +9,7 @@
  * [DESCRIPTION] :	This Project is to design a simple calculator to perform the
  * 			simple operations.
  * 			This operations include (Addition, Subtraction, Multiplication,
- * 			Division) between two operands.
+ * 			Division) between any number of operands.
  *
  * 			Design Considerations:
  *
@@ -18,36 +18,89 @@
  *			- Result should consider Negative number, Floating Point,
  *			  More than one operand.
  *
+ * Note: Numbers are written to the LCD through the fmt module in integer and fixed
+ * point, so neither the floating point library nor printf is linked.
  *
- * Note: "Project doesn't work correctly without these Steps"
+ * Note: The arithmetic is selected by EXPR_ARITHMETIC in expr.h: packed BCD numbers
+ * of 14 digits with 3 decimals (bcd module, default) or 32-bit fixed point (fixed
+ * module, Q20.12, range +/-524287), both round the results and report an overflow
+ * instead of wrapping around.
  *
- * As “There is no Floating Point Unit in AVR”. We can do that using a software library,
- * so follow these steps to add it:
+ * Note: The keys are fed to the expr module as they arrive, it keeps the operator
+ * precedence (12+3*4 = 24) and a result can be the first operand of the next
+ * expression by pressing an operator after '='.
  *
- * 1- After create your Project -> Right Click “Choose Properties” -> C/C++ Build “Setting”
- *    -> AVR C Linker “Libraries” -> Choose Add Button in “Libraries (-l)”
- *    -> Then Add (printf_flt).
- * 2- Also AVR C Linker “General” -> Then in “Other Arguments Tab” -> Then Add (-uvfprintf).
+ * Note: The keys are processed by the calc module, it uses no hardware and gives
+ * the text of the two bottom rows through CALC_display, so the same core is run on
+ * a PC by the test and benchmark in Calculator/Host.
+ *
+ * Note: Holding '*' enters the integer power operator '^' (2^10 = 1024) and holding
+ * '=' shows the functions menu on the top rows, the next key selects the function
+ * of the expression (1 SQRT, 2 SIN, 3 COS, 4 ATAN, 5 LOG2, 6 EXP2, angles in
+ * radians, calculated by the cordic module), any other key leaves the menu. The
+ * '*' and '=' keys act when they are released so a long press is not also taken
+ * as a short one.
+ *
+ * Note: Holding '+' adds the expression (or the result) to the memory register
+ * (M+), holding '-' subtracts it (M-), holding ON/C clears it (MC) and holding '/'
+ * shows the recall menu, where 0 enters the memory register (MR) and 1 --> 8 the
+ * last results (1 the newest). The memory register and the last 8 results are
+ * kept in the internal EEPROM through a RAM mirror (eeprom_mirror module): a
+ * recall reads the RAM only and the changed bytes are written from the EEPROM
+ * ready interrupt, so a key never waits for a write cycle (8.5 ms). The 2 banks of
+ * the store are written in turn, a bank gets the changes of the last 2 results
+ * (about 20 bytes with its sequence and checksum), so the history index of a bank
+ * is rewritten at every other result and lasts about 200,000 results (the EEPROM
+ * endurance).
  *
  *******************************************************************************************/
 
-#include <stdio.h>
-#include <stdlib.h>
-#include <stdint.h>
+#include "calc.h"
 #include "lcd.h"
+#include "lcd_queue.h"
 #include "keypad.h"
+#include "eeprom_mirror.h"
 
 /******************************************************************************************
  * 				 Preprocessor Macros   			   	          *
  ******************************************************************************************/
 
-#define NO_OP 0 /* NO operation */
-#define ADD 1 	/* Addition operation */
-#define SUB 2 	/* Subtraction operation */
-#define MUL 3 	/* Multiplication operation */
-#define DIV 4 	/* Division operation */
-#define EQL 5 	/* Equal operation */
-#define CLS 13 	/* Clear operation */
+#define CALC_FIRST_ROW 2	/* Row of the LCD showing the first row of the calculator */
+
+#define CALC_NO_ROW 0xFF	/* The LCD cursor position is not known */
+
+/* Number of functions in the menu, selected by the keys 1 --> CALC_FUNCTIONS */
+#define CALC_FUNCTIONS 6
+
+/* Menus displayed on the top rows, the next key selects an entry */
+#define CALC_MENU_NONE 0
+#define CALC_MENU_FUNCTIONS 1
+#define CALC_MENU_RECALL 2
+
+/* Keys having a long press, they act on their release unless they were held */
+#define CALC_HAS_LONG_PRESS(key) (((key) == '*') || ((key) == '=') || ((key) == '+') || \
+				  ((key) == '-') || ((key) == '/') || ((key) == CALC_KEY_CLEAR))
+
+/******************************************************************************************
+ *                           Global Variables                                             *
+ ******************************************************************************************/
+
+/* Position of the LCD cursor after the last write */
+static uint8 g_cursorRow = CALC_NO_ROW;
+static uint8 g_cursorCol = 0;
+
+/* Memory register and history, RAM mirror of the EEPROM */
+static CALC_StoreType g_store;
+
+/******************************************************************************************
+ *                      Functions Prototypes(Private)                                     *
+ ******************************************************************************************/
+
+/* Function responsible for writing a text of the calculator rows on the LCD */
+static void CALC_display(uint8 row,uint8 col,const char *Str);
+
+/* Function responsible for writing the two top rows of the LCD (title or functions menu) */
+static void CALC_showTitle(const char *Row0,const char *Row1);
 
 /*****************************************************************************************
  *                                MAIN FUNCTION                                          *
@@ -59,15 +112,18 @@ int main(void)
 	 *                           SYSTEM INITIALIZATION                              *
 	 ********************************************************************************/
 
-	uint8 key, operation, buf[16] = {0};	/* Buffer to store data that needed to display */
-	uint8 flage_op = 0;
-	float32 result;
-	sint16 var1 = 0, var2 = 0;	/* Two variables to store operands */
+	KeyPad_EventType event;
+	uint8 keyUsed = FALSE;	/* The held key gave a long press event or left a menu */
+	uint8 menu = CALC_MENU_NONE;	/* Menu displayed on the top rows */
 
 	LCD_init();	/*Initialize LCD */
-	LCD_displayStringRowColumn(0,0,"M.T Diploma 51");
-	LCD_displayStringRowColumn(1,0,"Enter operation:");
-	LCD_goToRowColumn(2,0);
+	LCD_QUEUE_init();	/* Initialize LCD output queue */
+	KeyPad_init();		/* Initialize keypad scanner */
+	CALC_showTitle("M.T Diploma 51  ", "Enter operation:");
+
+	/* Wrong checksums in both banks give an erased store, the calc module starts it empty */
+	EEPROM_MIRROR_init((uint8 *)&g_store, sizeof(CALC_StoreType));
+	CALC_init(CALC_display, &g_store, EEPROM_MIRROR_update);
 
 	/********************************************************************************
 	 *                        APPLICATION	(SUPER LOOP)			        *
@@ -75,92 +131,104 @@ int main(void)
 
 	while(1)
 	{
-		/* If any switch pressed for more than 200 ms it counts more than one press */
-		/* get the pressed key number */
-		key = KeyPad_getPressedKey();
-		_delay_ms(200); 			   /* Press time */
+		/* get the next key event, a held switch gives one press */
+		KeyPad_waitEvent(&event);
 
-		if( !( key >= 0 && key <= 9 ) )
+		if(event.edge == KEYPAD_LONG_PRESSED)
 		{
-			/* Check if the key pressed is operator (+ , -, *, /, =) */
-			switch(key)
+			keyUsed = TRUE;	/* The release of this key is not a short press */
+			switch(event.key)
 			{
-			case '+': flage_op = ADD;
-				  operation = '+';
-				  break;
-
-			case '-': flage_op = SUB;
-				  operation = '-';
-				  break;
-
-			case '*': flage_op = MUL;
-				  operation = '*';
-				  break;
-
-			case '/': flage_op = DIV;
-			          operation = '/';
-			          break;
-
-			case '=': flage_op = EQL;
-			          break;
+			case '*':
+				CALC_key(CALC_KEY_POWER);
+				break;
+			case '=':
+				menu = CALC_MENU_FUNCTIONS;
+				CALC_showTitle("1SQRT 2SIN 3COS ", "4ATAN 5LOG2 6EXP");
+				break;
+			case '+':
+				CALC_memory(CALC_MEMORY_ADD);
+				break;
+			case '-':
+				CALC_memory(CALC_MEMORY_SUBTRACT);
+				break;
+			case CALC_KEY_CLEAR:
+				CALC_memory(CALC_MEMORY_CLEAR);
+				break;
+			case '/':
+				menu = CALC_MENU_RECALL;
+				CALC_showTitle("RECALL 0:MEMORY ", "1-8:LAST RESULTS");
+				break;
 			}
 		}
-
-			if(flage_op == NO_OP)	/* Check if the key pressed is the first operand */
+		else if(event.edge == KEYPAD_RELEASED)
+		{
+			/* These keys act on their release, unless they were held */
+			if((!keyUsed) && CALC_HAS_LONG_PRESS(event.key))
 			{
-				var1 = var1*10 + key;
-				sprintf(buf,"%i",var1);
-				LCD_displayStringRowColumn(2, 0, buf);  	/* Display the pressed keypad switch */
+				CALC_key(event.key);
 			}
-
-			/* Check if the key pressed is the second operand */
-			else if(flage_op == ADD || flage_op == SUB || flage_op == MUL || flage_op == DIV)
+			keyUsed = FALSE;
+		}
+		else if(event.edge == KEYPAD_PRESSED)
+		{
+			if(menu != CALC_MENU_NONE)
 			{
-				if( !(key >= 0 && key <= 9) )
+				/* The key selects an entry, any other key leaves the menu */
+				CALC_showTitle("M.T Diploma 51  ", "Enter operation:");
+				if((menu == CALC_MENU_FUNCTIONS) && (event.key >= 1) && (event.key <= CALC_FUNCTIONS))
 				{
-					sprintf(buf,"%i%c",var1,operation);
-					LCD_displayStringRowColumn(2, 0, buf);  /* Display First operand and operator */
+					CALC_function((EXPR_FunctionType)(event.key - 1));
 				}
-				else
+				else if((menu == CALC_MENU_RECALL) && (event.key <= CALC_HISTORY_SIZE))
 				{
-					var2 = var2*10 + key;
-					sprintf(buf,"%i%c%i", var1, operation, var2);
-					/* Display First, Second operand and operator */
-					LCD_displayStringRowColumn(2, 0, buf);
+					CALC_recall(event.key);
 				}
+				menu = CALC_MENU_NONE;
+				keyUsed = TRUE;
 			}
-			/* Check if the Equal Button is pressed or not to display the result */
-			else if(flage_op == EQL)
+			else if(!CALC_HAS_LONG_PRESS(event.key))
 			{
-				switch(operation)
-				{
-				case '+': result = (float)var1+(float)var2;
-					  break;
-				case '-': result = (float)var1-(float)var2;
-					  break;
-				case '*': result = (float)var1*(float)var2;
-					  break;
-				case '/': result =(float)var1/(float)var2;
-					  break;
-				}
-
-				sprintf(buf, "=%.2f", result);
-				LCD_displayString(buf);
-				flage_op = NO_OP;
-				key = var1 = var2 = operation = 0;
-				while(KeyPad_getPressedKey() == '='){};	/* If pressed key is equal to '=' do nothing */
+				CALC_key(event.key);
 			}
+		}
+	}
+}
 
-			if(key == CLS)	/* Check if the 'C' Button is pressed or not,if it pressed clear the screen */
-			{
-				LCD_clearScreen();
-				LCD_displayStringRowColumn(0,0,"M.T Diploma 51");
-				LCD_displayStringRowColumn(1,0,"Enter operation:");
-				LCD_goToRowColumn(2,0);
-				flage_op = 0;
-				key = var1 = var2 = operation = 0;
-			}
+static void CALC_display(uint8 row,uint8 col,const char *Str)
+{
+	row += CALC_FIRST_ROW;
+
+	/*
+	 * Each entry waits for a free place in the queue, so nothing is dropped and the
+	 * cursor kept here always matches the LCD (this is the only producer of the queue,
+	 * so an entry never fails after the wait)
+	 */
+	if((row != g_cursorRow) || (col != g_cursorCol))
+	{
+		/* The cursor is moved only if the text does not follow the last write */
+		LCD_QUEUE_waitFreeEntries(1);
+		LCD_QUEUE_goToRowColumn(row, col);
+	}
 
-			key = 0;	/* Clear the key for Next round */
+	g_cursorRow = row;
+	for(g_cursorCol = col; *Str != '\0'; Str++)
+	{
+		LCD_QUEUE_waitFreeEntries(1);
+		LCD_QUEUE_displayCharacter(*Str);
+		g_cursorCol++;
 	}
 }
+
+static void CALC_showTitle(const char *Row0,const char *Row1)
+{
+	/*
+	 * The rows are written whole (16 characters) so no clear is needed, each one is
+	 * queued when there is room for its cursor move and all its characters
+	 */
+	LCD_QUEUE_waitFreeEntries(1 + LCD_COLUMNS);
+	LCD_QUEUE_displayStringRowColumn(0, 0, Row0);
+	LCD_QUEUE_waitFreeEntries(1 + LCD_COLUMNS);
+	LCD_QUEUE_displayStringRowColumn(1, 0, Row1);
+	g_cursorRow = CALC_NO_ROW;
+}
@@ -0,0 +1,444 @@
+ /******************************************************************************
+ *
+ * [MODULE]: CORDIC
+ *
+ * [FILE NAME]: cordic.c
+ *
+ * [DESCRIPTION]: Source file for the scientific functions of the fixed point
+ * 		  numbers
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include <avr/pgmspace.h>
+#include "cordic.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Fraction bits of the angles and logarithms inside the loops (range +/-8) */
+#define CORDIC_ANGLE_BITS	28
+
+/* Fraction bits of the CORDIC vector and of the exp2 mantissa (range +/-2) */
+#define CORDIC_UNIT_BITS	30
+
+/* Angles with CORDIC_ANGLE_BITS fraction bits */
+#define CORDIC_PI		843314857L
+#define CORDIC_HALF_PI		421657428L
+
+/* 2*pi with CORDIC_ANGLE_BITS fraction bits, and the fraction of it in 1/65536 */
+#define CORDIC_TWO_PI		1686629713UL
+#define CORDIC_TWO_PI_EXTRA	4276UL
+
+/* 2*pi with FIXED_FRACTION_BITS fraction bits */
+#define CORDIC_TWO_PI_FIXED	((sint32)((CORDIC_TWO_PI + ((uint32)1 << (CORDIC_ANGLE_SHIFT - 1))) >> CORDIC_ANGLE_SHIFT))
+
+/* Length of the CORDIC vector after the rotations: 1 / (product of sqrt(1 + 2^-2i)) */
+#define CORDIC_GAIN		652032874L
+
+/* Shift from the loop formats to FIXED_FRACTION_BITS */
+#define CORDIC_ANGLE_SHIFT	(CORDIC_ANGLE_BITS - FIXED_FRACTION_BITS)
+#define CORDIC_UNIT_SHIFT	(CORDIC_UNIT_BITS - FIXED_FRACTION_BITS)
+
+/* Arguments of exp2 out of the result range: 2^19 is over FIXED_MAX, 2^-13 rounds to zero */
+#define CORDIC_EXP2_MAX		((FIXED_Type)(31 - FIXED_FRACTION_BITS) * FIXED_ONE)
+#define CORDIC_EXP2_MIN		(-(FIXED_Type)(FIXED_FRACTION_BITS + 1) * FIXED_ONE)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* atan(2^-i) for i = 0 --> CORDIC_ITERATIONS - 1 with CORDIC_ANGLE_BITS fraction bits */
+static const sint32 g_atan[CORDIC_ITERATIONS] PROGMEM =
+{
+	210828714, 124459457, 65760959, 33381290, 16755422, 8385879, 4193963, 2097109,
+	1048571, 524287, 262144, 131072, 65536, 32768, 16384, 8192
+};
+
+/* log2(1 + 2^-i) for i = 1 --> CORDIC_ITERATIONS with CORDIC_ANGLE_BITS fraction bits */
+static const uint32 g_log2[CORDIC_ITERATIONS] PROGMEM =
+{
+	157024676, 86416915, 45613895, 23478128, 11916956, 6004314, 3013793, 1509828,
+	755650, 378009, 189051, 94537, 47271, 23636, 11818, 5909
+};
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/* Function responsible for calculating the sine and the cosine of an angle by the CORDIC rotations */
+static void CORDIC_rotate(FIXED_Type x,FIXED_Type * Sin_Ptr,FIXED_Type * Cos_Ptr);
+
+/* Function responsible for converting a loop result to fixed point, rounded to the nearest value */
+static FIXED_Type CORDIC_round(sint32 value,uint8 shift);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: CORDIC_sqrt
+ *
+ * [Description]: Function to calculate the square root of a number, rounded to
+ * 		  the nearest value
+ *
+ * [Args]:	  x, Result_Ptr
+ *
+ * [in]		  x: FIXED_Type (x >= 0)
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if x is negative (the result is zero)
+ *******************************************************************************/
+uint8 CORDIC_sqrt(FIXED_Type x,FIXED_Type * Result_Ptr)
+{
+	uint32 bits = (uint32)x;
+	uint32 root = 0;
+	uint32 remainder = 0;
+	uint32 trial;
+	uint8 i;
+
+	if(x < 0)
+	{
+		*Result_Ptr = 0;
+		return FALSE;
+	}
+
+	/*
+	 * sqrt(x * 2^F) has F fraction bits, the 32 bits of x followed by F zero bits
+	 * are taken two at a time and each pair gives one bit of the root
+	 */
+	for(i = 0; i < ((32 + FIXED_FRACTION_BITS) / 2); i++)
+	{
+		remainder = (remainder << 2) | (bits >> 30);
+		bits <<= 2;
+		trial = (root << 2) | 1;
+		root <<= 1;
+		if(remainder >= trial)
+		{
+			remainder -= trial;
+			root |= 1;
+		}
+	}
+
+	/* Round up if x * 2^F is over (root + 0.5)^2 = root^2 + root + 0.25 */
+	if(remainder > root)
+	{
+		root++;
+	}
+
+	*Result_Ptr = (FIXED_Type)root;
+	return TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]: CORDIC_sin
+ *
+ * [Description]: Function to calculate the sine of an angle in radians
+ *
+ * [Args]:	  x, Result_Ptr
+ *
+ * [in]		  x: FIXED_Type (angle in radians)
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE
+ *******************************************************************************/
+uint8 CORDIC_sin(FIXED_Type x,FIXED_Type * Result_Ptr)
+{
+	FIXED_Type cosine;
+
+	CORDIC_rotate(x, Result_Ptr, &cosine);
+	return TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]: CORDIC_cos
+ *
+ * [Description]: Function to calculate the cosine of an angle in radians
+ *
+ * [Args]:	  x, Result_Ptr
+ *
+ * [in]		  x: FIXED_Type (angle in radians)
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE
+ *******************************************************************************/
+uint8 CORDIC_cos(FIXED_Type x,FIXED_Type * Result_Ptr)
+{
+	FIXED_Type sine;
+
+	CORDIC_rotate(x, &sine, Result_Ptr);
+	return TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]: CORDIC_atan
+ *
+ * [Description]: Function to calculate the arc tangent of a number in radians
+ *
+ * [Args]:	  x, Result_Ptr
+ *
+ * [in]		  x: FIXED_Type
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type (-pi/2 --> pi/2)
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE
+ *******************************************************************************/
+uint8 CORDIC_atan(FIXED_Type x,FIXED_Type * Result_Ptr)
+{
+	uint32 magnitude = (x < 0) ? ((uint32)0 - (uint32)x) : (uint32)x;
+	uint8 inverse = (magnitude > FIXED_ONE) ? TRUE : FALSE;
+	uint32 ux = inverse ? magnitude : FIXED_ONE;	/* atan(1/x) = pi/2 - atan(x) */
+	uint32 uy = inverse ? FIXED_ONE : magnitude;
+	sint32 vx;
+	sint32 vy;
+	sint32 angle = 0;
+	sint32 temp;
+	uint8 i;
+
+	/* Scale the vector (x >= y >= 0) so x is 2^28 --> 2^29, its length grows to 2.33 * x at most */
+	while(ux >= ((uint32)1 << 29))
+	{
+		ux >>= 1;
+		uy >>= 1;
+	}
+	while(ux < ((uint32)1 << 28))
+	{
+		ux <<= 1;
+		uy <<= 1;
+	}
+	vx = (sint32)ux;
+	vy = (sint32)uy;
+
+	/* Rotate the vector to the x axis, the sum of the rotations is its angle */
+	for(i = 0; i < CORDIC_ITERATIONS; i++)
+	{
+		temp = vx;
+		if(vy >= 0)
+		{
+			vx += vy >> i;
+			vy -= temp >> i;
+			angle += (sint32)pgm_read_dword(&g_atan[i]);
+		}
+		else
+		{
+			vx -= vy >> i;
+			vy += temp >> i;
+			angle -= (sint32)pgm_read_dword(&g_atan[i]);
+		}
+	}
+
+	if(inverse)
+	{
+		angle = CORDIC_HALF_PI - angle;
+	}
+	*Result_Ptr = CORDIC_round((x < 0) ? -angle : angle, CORDIC_ANGLE_SHIFT);
+	return TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]: CORDIC_log2
+ *
+ * [Description]: Function to calculate the base 2 logarithm of a number
+ *
+ * [Args]:	  x, Result_Ptr
+ *
+ * [in]		  x: FIXED_Type (x > 0)
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if x is zero or negative (the result is zero)
+ *******************************************************************************/
+uint8 CORDIC_log2(FIXED_Type x,FIXED_Type * Result_Ptr)
+{
+	uint32 mantissa = (uint32)x;
+	sint8 exponent = CORDIC_UNIT_SHIFT;
+	uint32 sum = 0;
+	uint32 temp;
+	uint8 i;
+
+	if(x <= 0)
+	{
+		*Result_Ptr = 0;
+		return FALSE;
+	}
+
+	/* x = mantissa * 2^exponent with the mantissa 1 --> 2 (CORDIC_UNIT_BITS fraction bits) */
+	while(mantissa < ((uint32)1 << CORDIC_UNIT_BITS))
+	{
+		mantissa <<= 1;
+		exponent--;
+	}
+
+	/*
+	 * Multiply the mantissa by the factors (1 + 2^-i) that keep it below 2, then
+	 * log2(mantissa) = 1 - (sum of the log2 of the factors)
+	 */
+	for(i = 0; i < CORDIC_ITERATIONS; i++)
+	{
+		temp = mantissa + (mantissa >> (i + 1));
+		if(temp <= ((uint32)2 << CORDIC_UNIT_BITS))
+		{
+			mantissa = temp;
+			sum += pgm_read_dword(&g_log2[i]);
+		}
+	}
+
+	*Result_Ptr = ((FIXED_Type)exponent * FIXED_ONE) + CORDIC_round(((sint32)1 << CORDIC_ANGLE_BITS) - (sint32)sum, CORDIC_ANGLE_SHIFT);
+	return TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]: CORDIC_exp2
+ *
+ * [Description]: Function to calculate 2 to the power of a number
+ *
+ * [Args]:	  x, Result_Ptr
+ *
+ * [in]		  x: FIXED_Type
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated
+ *******************************************************************************/
+uint8 CORDIC_exp2(FIXED_Type x,FIXED_Type * Result_Ptr)
+{
+	sint8 exponent;
+	uint32 fraction;
+	uint32 mantissa = (uint32)1 << CORDIC_UNIT_BITS;
+	uint32 factor;
+	uint8 shift;
+	uint8 i;
+
+	if(x >= CORDIC_EXP2_MAX)
+	{
+		*Result_Ptr = FIXED_MAX;
+		return FALSE;
+	}
+	if(x < CORDIC_EXP2_MIN)
+	{
+		*Result_Ptr = 0;
+		return TRUE;
+	}
+
+	/* x = exponent + fraction with the fraction 0 --> 1 */
+	exponent = (sint8)(x >> FIXED_FRACTION_BITS);
+	fraction = ((uint32)x & (FIXED_ONE - 1)) << CORDIC_ANGLE_SHIFT;
+
+	/* 2^fraction is the product of the factors (1 + 2^-i) whose log2 sum to the fraction */
+	for(i = 0; i < CORDIC_ITERATIONS; i++)
+	{
+		factor = pgm_read_dword(&g_log2[i]);
+		if(fraction >= factor)
+		{
+			fraction -= factor;
+			mantissa += mantissa >> (i + 1);
+		}
+	}
+
+	/* The mantissa is 1 --> 2 with CORDIC_UNIT_BITS fraction bits, scale it by 2^exponent */
+	if(exponent >= CORDIC_UNIT_SHIFT)
+	{
+		*Result_Ptr = (FIXED_Type)(mantissa << (exponent - CORDIC_UNIT_SHIFT));
+	}
+	else
+	{
+		shift = CORDIC_UNIT_SHIFT - exponent;
+		*Result_Ptr = (FIXED_Type)((mantissa + ((uint32)1 << (shift - 1))) >> shift);
+	}
+	return TRUE;
+}
+
+static void CORDIC_rotate(FIXED_Type x,FIXED_Type * Sin_Ptr,FIXED_Type * Cos_Ptr)
+{
+	uint32 turns;
+	sint32 angle;
+	uint32 extra;
+	sint32 vx = CORDIC_GAIN;	/* The rotations multiply the length by 1 / CORDIC_GAIN */
+	sint32 vy = 0;
+	sint32 temp;
+	uint8 negateCos = FALSE;
+	uint8 i;
+
+	/*
+	 * Subtract the nearest multiple of 2*pi, the angle is calculated modulo 2^32 with
+	 * CORDIC_ANGLE_BITS fraction bits, it is correct because the result is -pi --> pi
+	 */
+	turns = ((x < 0) ? ((uint32)0 - (uint32)x) : (uint32)x) + (CORDIC_TWO_PI_FIXED / 2);
+	if(turns < CORDIC_TWO_PI_FIXED)
+	{
+		turns = 0;	/* -pi --> pi, the division is not needed */
+	}
+	else
+	{
+		turns /= CORDIC_TWO_PI_FIXED;
+	}
+	extra = ((turns * CORDIC_TWO_PI_EXTRA) + 0x8000UL) >> 16;
+	if(x < 0)
+	{
+		angle = (sint32)(((uint32)x << CORDIC_ANGLE_SHIFT) + (turns * CORDIC_TWO_PI) + extra);
+	}
+	else
+	{
+		angle = (sint32)(((uint32)x << CORDIC_ANGLE_SHIFT) - (turns * CORDIC_TWO_PI) - extra);
+	}
+
+	/* sin(pi - a) = sin(a) and cos(pi - a) = -cos(a), so the angle is -pi/2 --> pi/2 */
+	if(angle > CORDIC_HALF_PI)
+	{
+		angle = CORDIC_PI - angle;
+		negateCos = TRUE;
+	}
+	else if(angle < -CORDIC_HALF_PI)
+	{
+		angle = -CORDIC_PI - angle;
+		negateCos = TRUE;
+	}
+
+	/* Rotate the vector (1, 0) by the angle, it ends at (cos, sin) */
+	for(i = 0; i < CORDIC_ITERATIONS; i++)
+	{
+		temp = vx;
+		if(angle >= 0)
+		{
+			vx -= vy >> i;
+			vy += temp >> i;
+			angle -= (sint32)pgm_read_dword(&g_atan[i]);
+		}
+		else
+		{
+			vx += vy >> i;
+			vy -= temp >> i;
+			angle += (sint32)pgm_read_dword(&g_atan[i]);
+		}
+	}
+
+	*Sin_Ptr = CORDIC_round(vy, CORDIC_UNIT_SHIFT);
+	*Cos_Ptr = CORDIC_round(negateCos ? -vx : vx, CORDIC_UNIT_SHIFT);
+}
+
+static FIXED_Type CORDIC_round(sint32 value,uint8 shift)
+{
+	/* Rounded half away from zero, like the other fixed point operations */
+	if(value < 0)
+	{
+		return -(FIXED_Type)(((uint32)0 - (uint32)value + ((uint32)1 << (shift - 1))) >> shift);
+	}
+	return (FIXED_Type)(((uint32)value + ((uint32)1 << (shift - 1))) >> shift);
+}
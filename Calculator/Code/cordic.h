@@ -0,0 +1,169 @@
+ /******************************************************************************
+ *
+ * [MODULE]: CORDIC
+ *
+ * [FILE NAME]: cordic.h
+ *
+ * [DESCRIPTION]: Header file for the scientific functions of the fixed point
+ * 		  numbers, sin/cos/atan use the CORDIC rotations, log2/exp2
+ * 		  multiply by the factors (1 + 2^-i) and sqrt finds one bit of
+ * 		  the root per step, so every function is made of shifts, adds
+ * 		  and a table of constants in flash, without any multiplication
+ * 		  or the floating point library
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef CORDIC_H_
+#define CORDIC_H_
+
+#include "std_types.h"
+#include "fixed.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/*
+ * Steps of the CORDIC and log2/exp2 loops, each step adds about one correct bit,
+ * 16 steps leave an error below 1/4096 (the resolution of FIXED_FRACTION_BITS 12)
+ */
+#define CORDIC_ITERATIONS	16
+
+/*
+ * Accuracy for FIXED_FRACTION_BITS 12, measured on a PC against the C library by
+ * Calculator/Host/cordic_check (every argument up to +/-1024, or 0 --> 4096 for
+ * sqrt and log2, and samples of the whole range), in last bits (1/4096):
+ * sqrt: 0.5 (rounded to the nearest value)
+ * sin, cos: 0.63 for any angle, the range reduction keeps 2*pi to 44 bits
+ * atan: 0.63
+ * log2: 0.59
+ * exp2: 0.5 + relative error 2^-16
+ *
+ * Cycles on the ATmega16, estimated by hand from the instructions an optimised
+ * build (-Os) gives for the loops (a shift of a long by i bits takes about 6 * i
+ * cycles, a 32-bit division about 700). They are NOT measured, there is no AVR
+ * simulator or target in the tests:
+ * sqrt: 1200
+ * sin, cos: 2300 for -pi --> pi, 3000 with the range reduction division
+ * atan: 2500
+ * log2, exp2: 1700
+ *
+ * The Debug build of the project is -O0, it keeps every long on the stack and
+ * loads and stores it at each statement, about 2 times the cycles above (also an
+ * estimate). At the 1 MHz F_CPU a function then takes about 2.5 --> 6 ms, and 1.2
+ * --> 3 ms with -Os: this does NOT meet the "well under a few milliseconds" goal,
+ * only an 8 MHz clock (0.3 --> 0.8 ms at -O0) or a table driven sin/cos/log2/exp2
+ * would. Host/calc_bench counts the worst instructions of a function on the PC,
+ * it ranks the functions but gives no AVR time
+ */
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: CORDIC_sqrt
+ *
+ * [Description]: Function to calculate the square root of a number, rounded to
+ * 		  the nearest value
+ *
+ * [Args]:	  x, Result_Ptr
+ *
+ * [in]		  x: FIXED_Type (x >= 0)
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if x is negative (the result is zero)
+ *******************************************************************************/
+uint8 CORDIC_sqrt(FIXED_Type x,FIXED_Type * Result_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: CORDIC_sin
+ *
+ * [Description]: Function to calculate the sine of an angle in radians
+ *
+ * [Args]:	  x, Result_Ptr
+ *
+ * [in]		  x: FIXED_Type (angle in radians)
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE
+ *******************************************************************************/
+uint8 CORDIC_sin(FIXED_Type x,FIXED_Type * Result_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: CORDIC_cos
+ *
+ * [Description]: Function to calculate the cosine of an angle in radians
+ *
+ * [Args]:	  x, Result_Ptr
+ *
+ * [in]		  x: FIXED_Type (angle in radians)
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE
+ *******************************************************************************/
+uint8 CORDIC_cos(FIXED_Type x,FIXED_Type * Result_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: CORDIC_atan
+ *
+ * [Description]: Function to calculate the arc tangent of a number in radians
+ *
+ * [Args]:	  x, Result_Ptr
+ *
+ * [in]		  x: FIXED_Type
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type (-pi/2 --> pi/2)
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE
+ *******************************************************************************/
+uint8 CORDIC_atan(FIXED_Type x,FIXED_Type * Result_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: CORDIC_log2
+ *
+ * [Description]: Function to calculate the base 2 logarithm of a number
+ *
+ * [Args]:	  x, Result_Ptr
+ *
+ * [in]		  x: FIXED_Type (x > 0)
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if x is zero or negative (the result is zero)
+ *******************************************************************************/
+uint8 CORDIC_log2(FIXED_Type x,FIXED_Type * Result_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: CORDIC_exp2
+ *
+ * [Description]: Function to calculate 2 to the power of a number
+ *
+ * [Args]:	  x, Result_Ptr
+ *
+ * [in]		  x: FIXED_Type
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated
+ *******************************************************************************/
+uint8 CORDIC_exp2(FIXED_Type x,FIXED_Type * Result_Ptr);
+
+#endif /* CORDIC_H_ */
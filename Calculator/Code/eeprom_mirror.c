@@ -0,0 +1,358 @@
+ /******************************************************************************
+ *
+ * [MODULE]: EEPROM MIRROR
+ *
+ * [FILE NAME]: eeprom_mirror.c
+ *
+ * [DESCRIPTION]: Source file for the RAM mirror of the internal EEPROM
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include "eeprom_mirror.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static uint8 *g_mirror_Ptr;
+static uint16 g_size = 0;
+
+/*
+ * Range of the mirror still to be compared with each bank (g_pendingFirst[bank] -->
+ * g_pendingEnd[bank] - 1, empty if the first is >= the end), a change is added to
+ * the ranges of both banks and the copy to a bank empties its range only, the
+ * foreground code changes them with the interrupts disabled as they are 16-bit
+ */
+static volatile uint16 g_pendingFirst[2] = {0, 0};
+static volatile uint16 g_pendingEnd[2] = {0, 0};
+
+/* Bank written by the interrupt, the other bank holds the newest complete content */
+static volatile uint8 g_bank = 0;
+
+/* Sequence of the newest complete bank */
+static volatile uint8 g_sequence = 0;
+
+/* The sequence and the checksum of g_bank must be written after its pending range */
+static volatile uint8 g_commitPending = FALSE;
+
+/* Next step of the commit: 0 the sequence, 1 the checksum, 2 none (checksum written) */
+static volatile uint8 g_commitStep = 0;
+
+/* Checksum of the bank being committed, summed from its EEPROM bytes up to g_checksumAddress */
+static uint8 g_checksum = 0;
+static uint16 g_checksumAddress = 0;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/* Function responsible for giving the EEPROM address of the first byte of a bank */
+static uint16 EEPROM_MIRROR_bankBase(uint8 bank);
+
+/* Function responsible for copying a bank of the EEPROM to the mirror */
+static void EEPROM_MIRROR_load(uint8 bank);
+
+/* Function responsible for reading one byte of the EEPROM (no write cycle must be in progress) */
+static uint8 EEPROM_MIRROR_read(uint16 address);
+
+/* Function responsible for starting the write cycle of one byte (the interrupts must be disabled) */
+static void EEPROM_MIRROR_write(uint16 address,uint8 data);
+
+/* Function responsible for adding up bytes of the EEPROM (no write cycle must be in progress) */
+static uint8 EEPROM_MIRROR_sum(uint16 address,uint16 size);
+
+/*******************************************************************************
+ *                          ISR's Definitions                                  *
+ *******************************************************************************/
+
+ISR(EE_RDY_vect)
+{
+	uint8 count = 0;
+	uint8 bank = g_bank;
+	uint16 base = EEPROM_MIRROR_bankBase(bank);
+	uint16 address;
+	uint8 data;
+
+	/* Write the first pending byte that differs from the bank */
+	while(g_pendingFirst[bank] < g_pendingEnd[bank])
+	{
+		address = g_pendingFirst[bank];
+		g_pendingFirst[bank] = address + 1;
+		data = g_mirror_Ptr[address];
+		if(EEPROM_MIRROR_read(base + address) != data)
+		{
+			EEPROM_MIRROR_write(base + address, data);
+			return;		/* The interrupt comes again at the end of the write cycle */
+		}
+
+		count++;
+		if(count == EEPROM_MIRROR_ISR_BURST)
+		{
+			return;		/* The interrupt comes again at once, EEWE is still cleared */
+		}
+	}
+
+	/*
+	 * The sequence then the checksum are written last, the checksum covers them and
+	 * all the bytes of the bank, an update during the commit starts it again
+	 */
+	if(g_commitPending)
+	{
+		if(g_commitStep == 0)
+		{
+			g_commitStep = 1;
+			data = g_sequence + 1;
+			g_checksum = (uint8)(EEPROM_MIRROR_CHECKSUM_SEED + g_size + data);
+			g_checksumAddress = 0;
+			if(EEPROM_MIRROR_read(base + g_size) != data)
+			{
+				EEPROM_MIRROR_write(base + g_size, data);
+				return;
+			}
+		}
+		if(g_commitStep == 1)
+		{
+			/*
+			 * The bytes are read back from the bank, not taken from the mirror that
+			 * the foreground code may have changed since it was copied (the update
+			 * comes after the change), a burst at a time
+			 */
+			address = g_checksumAddress + EEPROM_MIRROR_ISR_BURST;
+			if(address < g_size)
+			{
+				g_checksum += EEPROM_MIRROR_sum(base + g_checksumAddress, EEPROM_MIRROR_ISR_BURST);
+				g_checksumAddress = address;
+				return;		/* The interrupt comes again at once, EEWE is still cleared */
+			}
+			g_checksum += EEPROM_MIRROR_sum(base + g_checksumAddress, g_size - g_checksumAddress);
+			g_checksumAddress = g_size;
+
+			g_commitStep = 2;
+			if(EEPROM_MIRROR_read(base + g_size + 1) != g_checksum)
+			{
+				EEPROM_MIRROR_write(base + g_size + 1, g_checksum);
+				return;
+			}
+		}
+
+		/* The bank holds the newest content now, the next changes go to the other one */
+		g_sequence++;
+		g_bank = bank ^ 1;
+		g_commitPending = FALSE;
+		g_commitStep = 0;
+	}
+
+	/* Everything is copied, wait for the next update */
+	CLEAR_BIT(EECR,EERIE);
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: EEPROM_MIRROR_init
+ *
+ * [Description]: Function to load the mirror from the valid bank of the EEPROM
+ * 		  with the newest sequence, it must be called once before any
+ * 		  other function of the module
+ *
+ * [Args]:	  Mirror_Ptr, size
+ *
+ * [in]		  size: Unsigned Short (bytes of the mirror, not more than
+ * 			EEPROM_MIRROR_MAX_SIZE)
+ *
+ * [out]	  Mirror_Ptr: Pointer to Unsigned Character (the mirror in RAM, it
+ * 			      must stay valid while the module is used)
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the checksums of both banks are wrong (erased
+ * 		  EEPROM), the mirror is then filled with 0xFF
+ *******************************************************************************/
+uint8 EEPROM_MIRROR_init(uint8 *Mirror_Ptr,uint16 size)
+{
+	uint8 valid[2];
+	uint8 sequence[2];
+	uint8 bank;
+	uint16 base;
+	uint16 address;
+
+	g_mirror_Ptr = Mirror_Ptr;
+	g_size = size;
+	g_commitPending = FALSE;
+	g_commitStep = 0;
+
+	/* Wait for a write cycle started before a reset */
+	while(BIT_IS_SET(EECR,EEWE))
+	{
+	}
+
+	/* Check both banks */
+	for(bank = 0; bank < 2; bank++)
+	{
+		base = EEPROM_MIRROR_bankBase(bank);
+		sequence[bank] = EEPROM_MIRROR_read(base + size);
+		valid[bank] = (EEPROM_MIRROR_read(base + size + 1) ==
+				(uint8)(EEPROM_MIRROR_CHECKSUM_SEED + size + sequence[bank] + EEPROM_MIRROR_sum(base, size))) ? TRUE : FALSE;
+	}
+
+	/* The newest valid bank, the sequence wraps around so the difference is compared */
+	if(valid[0] && ((!valid[1]) || ((uint8)(sequence[0] - sequence[1]) < 0x80)))
+	{
+		bank = 0;
+	}
+	else if(valid[1])
+	{
+		bank = 1;
+	}
+	else
+	{
+		/* Same content as an erased EEPROM, every byte of both banks is compared at their copy */
+		for(address = 0; address < size; address++)
+		{
+			Mirror_Ptr[address] = 0xFF;
+		}
+		g_sequence = 0;
+		g_bank = 0;
+		for(bank = 0; bank < 2; bank++)
+		{
+			g_pendingFirst[bank] = 0;
+			g_pendingEnd[bank] = size;
+		}
+		return FALSE;
+	}
+
+	EEPROM_MIRROR_load(bank);
+	g_sequence = sequence[bank];
+
+	/* The other bank is older or not valid, all its bytes are compared at its next copy */
+	g_bank = bank ^ 1;
+	g_pendingFirst[bank] = 0;
+	g_pendingEnd[bank] = 0;
+	g_pendingFirst[bank ^ 1] = 0;
+	g_pendingEnd[bank ^ 1] = size;
+	return TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]: EEPROM_MIRROR_update
+ *
+ * [Description]: Function to copy bytes of the mirror that changed to the
+ * 		  EEPROM, it returns at once and the copy is done by the
+ * 		  interrupt, the ranges of calls made before the copy reaches
+ * 		  them are merged, and the bytes equal to the content of the
+ * 		  bank are not written (only the last value of a byte is written)
+ *
+ * [Args]:	  address, size
+ *
+ * [in]		  address: Unsigned Short (first changed byte of the mirror)
+ * 		  size: Unsigned Short (number of changed bytes)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void EEPROM_MIRROR_update(uint16 address,uint16 size)
+{
+	uint16 end = address + size;
+	uint8 sreg = SREG;
+	uint8 bank;
+
+	/* The interrupt reads the ranges, so change them with the interrupts disabled */
+	SREG &= ~(1<<7);
+	for(bank = 0; bank < 2; bank++)
+	{
+		if(g_pendingFirst[bank] >= g_pendingEnd[bank])
+		{
+			g_pendingFirst[bank] = address;
+			g_pendingEnd[bank] = end;
+		}
+		else
+		{
+			/* Both ranges are merged, the unchanged bytes between them are only compared */
+			if(address < g_pendingFirst[bank])
+			{
+				g_pendingFirst[bank] = address;
+			}
+			if(end > g_pendingEnd[bank])
+			{
+				g_pendingEnd[bank] = end;
+			}
+		}
+	}
+	g_commitPending = TRUE;
+	g_commitStep = 0;
+	SET_BIT(EECR,EERIE);	/* The interrupt is taken as soon as no write cycle is in progress */
+	SREG = sreg;
+}
+
+/*******************************************************************************
+ * [Function Name]: EEPROM_MIRROR_isBusy
+ *
+ * [Description]: Function to check if changes of the mirror are not yet in the
+ * 		  EEPROM (before a sleep or a power down for example)
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  Unsigned Character
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if a copy is in progress, otherwise FALSE
+ *******************************************************************************/
+uint8 EEPROM_MIRROR_isBusy(void)
+{
+	return BIT_IS_SET(EECR,EERIE) ? TRUE : FALSE;
+}
+
+static uint16 EEPROM_MIRROR_bankBase(uint8 bank)
+{
+	return (bank == 0) ? 0 : (g_size + EEPROM_MIRROR_BANK_OVERHEAD);
+}
+
+static void EEPROM_MIRROR_load(uint8 bank)
+{
+	uint16 base = EEPROM_MIRROR_bankBase(bank);
+	uint16 address;
+
+	for(address = 0; address < g_size; address++)
+	{
+		g_mirror_Ptr[address] = EEPROM_MIRROR_read(base + address);
+	}
+}
+
+static uint8 EEPROM_MIRROR_read(uint16 address)
+{
+	EEAR = address;
+	SET_BIT(EECR,EERE);
+	return EEDR;
+}
+
+static void EEPROM_MIRROR_write(uint16 address,uint8 data)
+{
+	EEAR = address;
+	EEDR = data;
+
+	/* EEWE must be set within 4 cycles after EEMWE */
+	SET_BIT(EECR,EEMWE);
+	SET_BIT(EECR,EEWE);
+}
+
+static uint8 EEPROM_MIRROR_sum(uint16 address,uint16 size)
+{
+	uint8 sum = 0;
+
+	for(; size > 0; size--)
+	{
+		sum += EEPROM_MIRROR_read(address);
+		address++;
+	}
+	return sum;
+}
@@ -0,0 +1,122 @@
+ /******************************************************************************
+ *
+ * [MODULE]: EEPROM MIRROR
+ *
+ * [FILE NAME]: eeprom_mirror.h
+ *
+ * [DESCRIPTION]: Header file for the RAM mirror of the internal EEPROM, the
+ * 		  application reads and changes the mirror only and tells which
+ * 		  bytes changed, they are copied to the EEPROM from the EEPROM
+ * 		  ready interrupt one byte per write cycle, so no write cycle
+ * 		  (8.5 ms) is ever waited for by the application
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef EEPROM_MIRROR_H_
+#define EEPROM_MIRROR_H_
+
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/*
+ * The EEPROM holds 2 banks of the mirror, each one is the size bytes followed by a
+ * sequence byte and a checksum byte (bank 0 at the address 0 and bank 1 at the
+ * address size + 2), so the mirror can be 254 bytes at most on the ATmega16 (512
+ * bytes EEPROM)
+ */
+#define EEPROM_MIRROR_BANK_OVERHEAD	2
+#define EEPROM_MIRROR_MAX_SIZE		(512 / 2 - EEPROM_MIRROR_BANK_OVERHEAD)
+
+/*
+ * The changes are copied to the bank that does not hold the newest content, then
+ * its sequence (the sequence of the other bank + 1) and its checksum (summed from
+ * the bytes read back from the bank, not from the mirror) are written, a reset
+ * during the copy leaves a wrong checksum in this bank only and the next
+ * EEPROM_MIRROR_init loads the other bank (the content before the last changes)
+ * instead of a mix of old and new bytes, the seed makes an erased EEPROM (all
+ * 0xFF) not valid
+ */
+#define EEPROM_MIRROR_CHECKSUM_SEED	0x5A
+
+/*
+ * Maximum number of bytes compared or added to the checksum in one interrupt, the
+ * bytes that did not change are read and skipped (4 cycles each) without a write
+ * cycle, it bounds the time of the interrupt when a large range is marked as
+ * changed and when the checksum of the bank is calculated
+ */
+#define EEPROM_MIRROR_ISR_BURST		16
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: EEPROM_MIRROR_init
+ *
+ * [Description]: Function to load the mirror from the valid bank of the EEPROM
+ * 		  with the newest sequence, it must be called once before any
+ * 		  other function of the module
+ *
+ * [Args]:	  Mirror_Ptr, size
+ *
+ * [in]		  size: Unsigned Short (bytes of the mirror, not more than
+ * 			EEPROM_MIRROR_MAX_SIZE)
+ *
+ * [out]	  Mirror_Ptr: Pointer to Unsigned Character (the mirror in RAM, it
+ * 			      must stay valid while the module is used)
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the checksums of both banks are wrong (erased
+ * 		  EEPROM), the mirror is then filled with 0xFF
+ *******************************************************************************/
+uint8 EEPROM_MIRROR_init(uint8 *Mirror_Ptr,uint16 size);
+
+/*******************************************************************************
+ * [Function Name]: EEPROM_MIRROR_update
+ *
+ * [Description]: Function to copy bytes of the mirror that changed to the
+ * 		  EEPROM, it returns at once and the copy is done by the
+ * 		  interrupt, the ranges of calls made before the copy reaches
+ * 		  them are merged, and the bytes equal to the content of the
+ * 		  bank are not written (only the last value of a byte is written)
+ *
+ * [Args]:	  address, size
+ *
+ * [in]		  address: Unsigned Short (first changed byte of the mirror)
+ * 		  size: Unsigned Short (number of changed bytes)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void EEPROM_MIRROR_update(uint16 address,uint16 size);
+
+/*******************************************************************************
+ * [Function Name]: EEPROM_MIRROR_isBusy
+ *
+ * [Description]: Function to check if changes of the mirror are not yet in the
+ * 		  EEPROM (before a sleep or a power down for example)
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  Unsigned Character
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if a copy is in progress, otherwise FALSE
+ *******************************************************************************/
+uint8 EEPROM_MIRROR_isBusy(void);
+
+#endif /* EEPROM_MIRROR_H_ */
@@ -0,0 +1,637 @@
+ /******************************************************************************
+ *
+ * [MODULE]: EXPRESSION
+ *
+ * [FILE NAME]: expr.c
+ *
+ * [DESCRIPTION]: Source file for the expression engine
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include "expr.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Entry states of the expression */
+#define EXPR_EXPECT_NUMBER	0	/* Start of the expression or after an operator */
+#define EXPR_IN_NUMBER		1	/* Digits of a number are being entered */
+#define EXPR_AFTER_NUMBER	2	/* A complete number is added */
+
+/* Operator of the number tokens */
+#define EXPR_NUMBER		0
+
+/* Operations of the selected arithmetic, the numbers are passed by address */
+#if (EXPR_ARITHMETIC == EXPR_BCD)
+#define EXPR_CLEAR(a)		BCD_clear(a)
+#define EXPR_NEGATE(a)		BCD_negate(a)
+#define EXPR_IS_ZERO(a)		BCD_isZero(a)
+#define EXPR_ADD(a,b,result)	BCD_add((a),(b),(result))
+#define EXPR_SUB(a,b,result)	BCD_sub((a),(b),(result))
+#define EXPR_MUL(a,b,result)	BCD_mul((a),(b),(result))
+#define EXPR_DIV(a,b,result)	BCD_div((a),(b),(result))
+#else
+#define EXPR_CLEAR(a)		(*(a) = 0)
+#define EXPR_NEGATE(a)		FIXED_sub(0,*(a),(a))
+#define EXPR_IS_ZERO(a)		(*(a) == 0)
+#define EXPR_ADD(a,b,result)	FIXED_add(*(a),*(b),(result))
+#define EXPR_SUB(a,b,result)	FIXED_sub(*(a),*(b),(result))
+#define EXPR_MUL(a,b,result)	FIXED_mul(*(a),*(b),(result))
+#define EXPR_DIV(a,b,result)	FIXED_div(*(a),*(b),(result))
+#endif
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	uint8 op;		/* EXPR_NUMBER or the operator character */
+	EXPR_NumberType value;
+}EXPR_TokenType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Tokens in postfix order */
+static EXPR_TokenType g_output[EXPR_MAX_TOKENS];
+static uint8 g_outputCount;
+
+/* Operators waiting for an operator of lower precedence */
+static uint8 g_operators[EXPR_MAX_TOKENS];
+static uint8 g_operatorsCount;
+
+/* Operands of the evaluation, an expression has at most one number more than its operators */
+static EXPR_NumberType g_values[(EXPR_MAX_TOKENS / 2) + 1];
+
+/* Tokens entered, including the number being entered */
+static uint8 g_tokens;
+
+/* Number being entered (integer) and its sign */
+static EXPR_NumberType g_number;
+static uint8 g_negative;
+
+static uint8 g_state;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/* Function responsible for returning the precedence of an operator */
+static uint8 EXPR_precedence(uint8 op);
+
+/* Function responsible for moving the number being entered to the output */
+static void EXPR_finishNumber(void);
+
+/* Function responsible for adding a digit to the right of an integer, returns FALSE if it is full */
+static uint8 EXPR_appendDigit(EXPR_NumberType * Number_Ptr,uint8 digit);
+
+/* Function responsible for calculating one operation, the result can be one of the operands */
+static EXPR_StatusType EXPR_apply(uint8 op,const EXPR_NumberType * a,const EXPR_NumberType * b,EXPR_NumberType * Result_Ptr);
+
+/* Function responsible for calculating a ^ n by squaring and multiplying, n must be an integer */
+static EXPR_StatusType EXPR_power(const EXPR_NumberType * a,const EXPR_NumberType * n,EXPR_NumberType * Result_Ptr);
+
+/* Function responsible for converting a number to fixed point, returns FALSE if it is out of range */
+static uint8 EXPR_toFixed(const EXPR_NumberType * Value_Ptr,FIXED_Type * Result_Ptr);
+
+/* Function responsible for converting a fixed point number to a number of the engine */
+static void EXPR_fromFixed(FIXED_Type value,EXPR_NumberType * Result_Ptr);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: EXPR_init
+ *
+ * [Description]: Function to start a new empty expression
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void EXPR_init(void)
+{
+	g_outputCount = 0;
+	g_operatorsCount = 0;
+	g_tokens = 0;
+	EXPR_CLEAR(&g_number);
+	g_negative = FALSE;
+	g_state = EXPR_EXPECT_NUMBER;
+}
+
+/*******************************************************************************
+ * [Function Name]: EXPR_digit
+ *
+ * [Description]: Function to add a digit to the number being entered
+ *
+ * [Args]:	  digit
+ *
+ * [in]		  digit: Unsigned Character (0 --> 9)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     EXPR_OK, EXPR_ERROR_SYNTAX if a number can not start here or
+ * 		  EXPR_ERROR_OVERFLOW if the number is too long (the digit is
+ * 		  ignored in both cases)
+ *******************************************************************************/
+EXPR_StatusType EXPR_digit(uint8 digit)
+{
+	if(g_state == EXPR_AFTER_NUMBER)
+	{
+		return EXPR_ERROR_SYNTAX;
+	}
+
+	if(g_state == EXPR_EXPECT_NUMBER)
+	{
+		/* First digit, the room of the number token is checked by the operator before it */
+		EXPR_CLEAR(&g_number);
+		g_tokens++;
+		g_state = EXPR_IN_NUMBER;
+	}
+
+	return EXPR_appendDigit(&g_number, digit) ? EXPR_OK : EXPR_ERROR_OVERFLOW;
+}
+
+/*******************************************************************************
+ * [Function Name]: EXPR_number
+ *
+ * [Description]: Function to add a complete number (the previous result for
+ * 		  example), no digit can follow it
+ *
+ * [Args]:	  Value_Ptr
+ *
+ * [in]		  Value_Ptr: Pointer to EXPR_NumberType
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     EXPR_OK or EXPR_ERROR_SYNTAX if a number can not start here
+ *******************************************************************************/
+EXPR_StatusType EXPR_number(const EXPR_NumberType * Value_Ptr)
+{
+	if(g_state != EXPR_EXPECT_NUMBER)
+	{
+		return EXPR_ERROR_SYNTAX;
+	}
+
+	g_output[g_outputCount].op = EXPR_NUMBER;
+	g_output[g_outputCount].value = *Value_Ptr;
+	if(g_negative)
+	{
+		EXPR_NEGATE(&g_output[g_outputCount].value);
+	}
+	g_outputCount++;
+	g_tokens++;
+	g_negative = FALSE;
+	g_state = EXPR_AFTER_NUMBER;
+	return EXPR_OK;
+}
+
+/*******************************************************************************
+ * [Function Name]: EXPR_operator
+ *
+ * [Description]: Function to add an operator, a '-' where a number is expected
+ * 		  is the sign of the next number
+ *
+ * [Args]:	  op
+ *
+ * [in]		  op: Unsigned Character ('+', '-', '*' or '/')
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     EXPR_OK, EXPR_ERROR_SYNTAX if an operator can not be added
+ * 		  here or EXPR_ERROR_FULL if the expression has EXPR_MAX_TOKENS
+ * 		  tokens (the operator is ignored in both cases)
+ *******************************************************************************/
+EXPR_StatusType EXPR_operator(uint8 op)
+{
+	uint8 precedence = EXPR_precedence(op);
+
+	if(precedence == 0)
+	{
+		return EXPR_ERROR_SYNTAX;	/* Not an operator */
+	}
+
+	if(g_state == EXPR_EXPECT_NUMBER)
+	{
+		if((op == '-') && (!g_negative))
+		{
+			g_negative = TRUE;	/* Sign of the next number */
+			return EXPR_OK;
+		}
+		return EXPR_ERROR_SYNTAX;
+	}
+
+	/* The operator needs room for itself and for the number after it */
+	if(g_tokens > (EXPR_MAX_TOKENS - 2))
+	{
+		return EXPR_ERROR_FULL;
+	}
+
+	EXPR_finishNumber();
+
+	/*
+	 * Shunting-yard: the waiting operators of higher or equal precedence are calculated
+	 * first, except a power after a power (calculated from right to left)
+	 */
+	while((g_operatorsCount > 0) && (EXPR_precedence(g_operators[g_operatorsCount - 1]) >= precedence) &&
+	      ((op != EXPR_POWER) || (g_operators[g_operatorsCount - 1] != EXPR_POWER)))
+	{
+		g_operatorsCount--;
+		g_output[g_outputCount].op = g_operators[g_operatorsCount];
+		g_outputCount++;
+	}
+	g_operators[g_operatorsCount] = op;
+	g_operatorsCount++;
+	g_tokens++;
+
+	g_state = EXPR_EXPECT_NUMBER;
+	return EXPR_OK;
+}
+
+/*******************************************************************************
+ * [Function Name]: EXPR_evaluate
+ *
+ * [Description]: Function to calculate the expression, a new empty expression
+ * 		  is started after it whatever the result
+ *
+ * [Args]:	  Result_Ptr
+ *
+ * [in]		  None
+ *
+ * [out]	  Result_Ptr: Pointer to EXPR_NumberType
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     EXPR_OK or the error that stopped the calculation
+ *******************************************************************************/
+EXPR_StatusType EXPR_evaluate(EXPR_NumberType * Result_Ptr)
+{
+	EXPR_StatusType status = EXPR_OK;
+	uint8 count = 0;	/* Number of operands in g_values */
+	uint8 i;
+
+	if(g_state == EXPR_EXPECT_NUMBER)
+	{
+		EXPR_init();
+		return EXPR_ERROR_SYNTAX;	/* Empty expression or operator at the end */
+	}
+
+	EXPR_finishNumber();
+	while(g_operatorsCount > 0)
+	{
+		g_operatorsCount--;
+		g_output[g_outputCount].op = g_operators[g_operatorsCount];
+		g_outputCount++;
+	}
+
+	for(i = 0; (i < g_outputCount) && (status == EXPR_OK); i++)
+	{
+		if(g_output[i].op == EXPR_NUMBER)
+		{
+			g_values[count] = g_output[i].value;
+			count++;
+		}
+		else
+		{
+			count--;
+			status = EXPR_apply(g_output[i].op, &g_values[count - 1], &g_values[count], &g_values[count - 1]);
+		}
+	}
+
+	if(status == EXPR_OK)
+	{
+		*Result_Ptr = g_values[0];
+	}
+	EXPR_init();
+	return status;
+}
+
+/*******************************************************************************
+ * [Function Name]: EXPR_format
+ *
+ * [Description]: Function to write a number in decimal without the zeros at
+ * 		  the end of its fraction
+ *
+ * [Args]:	  Str, Value_Ptr
+ *
+ * [in]		  Value_Ptr: Pointer to EXPR_NumberType
+ *
+ * [out]	  Str: Pointer to character (buffer of EXPR_TEXT_SIZE characters)
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     Number of characters written without the null terminator
+ *******************************************************************************/
+uint8 EXPR_format(char *Str,const EXPR_NumberType * Value_Ptr)
+{
+#if (EXPR_ARITHMETIC == EXPR_BCD)
+	/* The BCD digits are written directly */
+	return BCD_toString(Str, Value_Ptr);
+#else
+	sint32 decimal = FIXED_toDecimal(*Value_Ptr, EXPR_DECIMALS);
+	uint8 decimals = EXPR_DECIMALS;
+
+	while((decimals > 0) && ((decimal % 10) == 0))
+	{
+		decimal /= 10;
+		decimals--;
+	}
+	return FMT_fixed(Str, decimal, decimals, 0, FMT_PAD_SPACE);
+#endif
+}
+
+/*******************************************************************************
+ * [Function Name]: EXPR_function
+ *
+ * [Description]: Function to calculate a scientific function of a number (the
+ * 		  result of an expression for example) with the cordic module,
+ * 		  the angles are in radians
+ *
+ * [Args]:	  function, Value_Ptr, Result_Ptr
+ *
+ * [in]		  function: EXPR_FunctionType
+ * 		  Value_Ptr: Pointer to EXPR_NumberType
+ *
+ * [out]	  Result_Ptr: Pointer to EXPR_NumberType
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     EXPR_OK, EXPR_ERROR_OVERFLOW if the number or the result is
+ * 		  out of the fixed point range or EXPR_ERROR_MATH if the number
+ * 		  is out of the domain of the function
+ *******************************************************************************/
+EXPR_StatusType EXPR_function(EXPR_FunctionType function,const EXPR_NumberType * Value_Ptr,EXPR_NumberType * Result_Ptr)
+{
+	FIXED_Type x;
+	FIXED_Type result;
+	uint8 valid;
+
+	if(!EXPR_toFixed(Value_Ptr, &x))
+	{
+		return EXPR_ERROR_OVERFLOW;
+	}
+
+	switch(function)
+	{
+	case EXPR_SQRT:
+		valid = CORDIC_sqrt(x, &result);
+		break;
+	case EXPR_SIN:
+		valid = CORDIC_sin(x, &result);
+		break;
+	case EXPR_COS:
+		valid = CORDIC_cos(x, &result);
+		break;
+	case EXPR_ATAN:
+		valid = CORDIC_atan(x, &result);
+		break;
+	case EXPR_LOG2:
+		valid = CORDIC_log2(x, &result);
+		break;
+	default:
+		if(!CORDIC_exp2(x, &result))
+		{
+			return EXPR_ERROR_OVERFLOW;
+		}
+		valid = TRUE;
+		break;
+	}
+
+	if(!valid)
+	{
+		return EXPR_ERROR_MATH;
+	}
+	EXPR_fromFixed(result, Result_Ptr);
+	return EXPR_OK;
+}
+
+/*******************************************************************************
+ * [Function Name]: EXPR_calculate
+ *
+ * [Description]: Function to calculate one operation between two numbers
+ * 		  outside of the expression (the memory register for example),
+ * 		  the result is written only if it is in range
+ *
+ * [Args]:	  op, a, b, Result_Ptr
+ *
+ * [in]		  op: Unsigned Character ('+', '-', '*', '/' or EXPR_POWER)
+ * 		  a, b: Pointer to EXPR_NumberType
+ *
+ * [out]	  Result_Ptr: Pointer to EXPR_NumberType
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     EXPR_OK, EXPR_ERROR_OVERFLOW or EXPR_ERROR_DIVIDE_BY_ZERO
+ *******************************************************************************/
+EXPR_StatusType EXPR_calculate(uint8 op,const EXPR_NumberType * a,const EXPR_NumberType * b,EXPR_NumberType * Result_Ptr)
+{
+	EXPR_NumberType result;
+	EXPR_StatusType status = EXPR_apply(op, a, b, &result);
+
+	/* The arithmetic saturates the result of an overflow, it is not kept */
+	if(status == EXPR_OK)
+	{
+		*Result_Ptr = result;
+	}
+	return status;
+}
+
+/*******************************************************************************
+ * [Function Name]: EXPR_clear
+ *
+ * [Description]: Function to set a number to zero
+ *
+ * [Args]:	  Number_Ptr
+ *
+ * [in]		  None
+ *
+ * [out]	  Number_Ptr: Pointer to EXPR_NumberType
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void EXPR_clear(EXPR_NumberType * Number_Ptr)
+{
+	EXPR_CLEAR(Number_Ptr);
+}
+
+static uint8 EXPR_precedence(uint8 op)
+{
+	switch(op)
+	{
+	case '+':
+	case '-':
+		return 1;
+	case '*':
+	case '/':
+		return 2;
+	case EXPR_POWER:
+		return 3;
+	default:
+		return 0;
+	}
+}
+
+static void EXPR_finishNumber(void)
+{
+	if(g_state == EXPR_IN_NUMBER)
+	{
+		g_output[g_outputCount].op = EXPR_NUMBER;
+		if(g_negative)
+		{
+			EXPR_NEGATE(&g_number);
+		}
+		g_output[g_outputCount].value = g_number;
+		g_outputCount++;
+		g_negative = FALSE;
+		g_state = EXPR_AFTER_NUMBER;
+	}
+}
+
+static uint8 EXPR_appendDigit(EXPR_NumberType * Number_Ptr,uint8 digit)
+{
+#if (EXPR_ARITHMETIC == EXPR_BCD)
+	return BCD_appendDigit(Number_Ptr, digit);
+#else
+	sint32 integer = *Number_Ptr >> FIXED_FRACTION_BITS;
+
+	if(integer > ((FIXED_MAX_INTEGER - digit) / 10))
+	{
+		return FALSE;
+	}
+	*Number_Ptr = ((integer * 10) + digit) << FIXED_FRACTION_BITS;
+	return TRUE;
+#endif
+}
+
+static EXPR_StatusType EXPR_apply(uint8 op,const EXPR_NumberType * a,const EXPR_NumberType * b,EXPR_NumberType * Result_Ptr)
+{
+	uint8 inRange;
+
+	switch(op)
+	{
+	case '+':
+		inRange = EXPR_ADD(a, b, Result_Ptr);
+		break;
+	case '-':
+		inRange = EXPR_SUB(a, b, Result_Ptr);
+		break;
+	case '*':
+		inRange = EXPR_MUL(a, b, Result_Ptr);
+		break;
+	case EXPR_POWER:
+		return EXPR_power(a, b, Result_Ptr);
+	default:
+		if(EXPR_IS_ZERO(b))
+		{
+			return EXPR_ERROR_DIVIDE_BY_ZERO;
+		}
+		inRange = EXPR_DIV(a, b, Result_Ptr);
+		break;
+	}
+
+	return inRange ? EXPR_OK : EXPR_ERROR_OVERFLOW;
+}
+
+static EXPR_StatusType EXPR_power(const EXPR_NumberType * a,const EXPR_NumberType * n,EXPR_NumberType * Result_Ptr)
+{
+	EXPR_NumberType base = *a;
+	EXPR_NumberType result;
+	FIXED_Type exponent;
+	uint32 bits;
+	uint8 negative;
+
+	/* The exponent must be an integer, any decimal of it gives fraction bits in fixed point */
+	if((!EXPR_toFixed(n, &exponent)) || ((exponent & (FIXED_ONE - 1)) != 0))
+	{
+		return EXPR_ERROR_MATH;
+	}
+
+	negative = (exponent < 0) ? TRUE : FALSE;
+	bits = (negative ? ((uint32)0 - (uint32)exponent) : (uint32)exponent) >> FIXED_FRACTION_BITS;
+
+	/* result = 1, then multiplied by base^(2^i) for each bit i of the exponent */
+	EXPR_CLEAR(&result);
+	EXPR_appendDigit(&result, 1);
+	while(bits != 0)
+	{
+		if((bits & 1) != 0)
+		{
+			if(!EXPR_MUL(&result, &base, &result))
+			{
+				return EXPR_ERROR_OVERFLOW;
+			}
+		}
+		bits >>= 1;
+
+		/* A square larger than the range is used by the next bits, a zero square stays zero */
+		if((bits != 0) && (!EXPR_MUL(&base, &base, &base)))
+		{
+			return EXPR_ERROR_OVERFLOW;
+		}
+		if(EXPR_IS_ZERO(&base))
+		{
+			bits = 0;
+			EXPR_CLEAR(&result);
+		}
+	}
+
+	if(negative)
+	{
+		/* a ^ -n = 1 / a ^ n */
+		if(EXPR_IS_ZERO(&result))
+		{
+			return EXPR_ERROR_DIVIDE_BY_ZERO;
+		}
+		EXPR_CLEAR(&base);
+		EXPR_appendDigit(&base, 1);
+		if(!EXPR_DIV(&base, &result, &result))
+		{
+			return EXPR_ERROR_OVERFLOW;
+		}
+	}
+
+	*Result_Ptr = result;
+	return EXPR_OK;
+}
+
+static uint8 EXPR_toFixed(const EXPR_NumberType * Value_Ptr,FIXED_Type * Result_Ptr)
+{
+#if (EXPR_ARITHMETIC == EXPR_BCD)
+	sint32 scaled;
+
+	return BCD_toScaled(Value_Ptr, &scaled) && FIXED_fromDecimal(scaled, BCD_DECIMALS, Result_Ptr);
+#else
+	*Result_Ptr = *Value_Ptr;
+	return TRUE;
+#endif
+}
+
+static void EXPR_fromFixed(FIXED_Type value,EXPR_NumberType * Result_Ptr)
+{
+#if (EXPR_ARITHMETIC == EXPR_BCD)
+	/* Every fixed point number fits in a BCD number */
+	BCD_fromScaled(FIXED_toDecimal(value, BCD_DECIMALS), Result_Ptr);
+#else
+	*Result_Ptr = value;
+#endif
+}
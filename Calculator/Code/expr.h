@@ -0,0 +1,268 @@
+ /******************************************************************************
+ *
+ * [MODULE]: EXPRESSION
+ *
+ * [FILE NAME]: expr.h
+ *
+ * [DESCRIPTION]: Header file for the expression engine, the keys are fed one by
+ * 		  one and each complete token is moved by the shunting-yard
+ * 		  algorithm into a fixed size buffer in postfix order, so the
+ * 		  operator precedence is respected (12+3*4 = 24) and the
+ * 		  evaluation works on static stacks in a bounded time, the
+ * 		  module uses no hardware so it also builds on a PC
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef EXPR_H_
+#define EXPR_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Arithmetic of the engine */
+#define EXPR_FIXED_POINT	0	/* 32-bit binary fixed point (fixed module) */
+#define EXPR_BCD		1	/* Packed BCD decimal numbers (bcd module) */
+
+/*
+ * Arithmetic used by the engine: EXPR_BCD gives exact decimal numbers of BCD_DIGITS
+ * digits, EXPR_FIXED_POINT is smaller and faster but limited to +/-524287
+ */
+#define EXPR_ARITHMETIC		EXPR_BCD
+
+/*
+ * The functions (EXPR_function) work in fixed point with the cordic module for both
+ * arithmetics, so their numbers are limited to +/-524287 and their results have a
+ * resolution of 1/4096 (the third decimal can be one off), the conversion of a BCD
+ * number to fixed point and back adds about 1500 cycles (estimated)
+ */
+#include "cordic.h"
+
+#if (EXPR_ARITHMETIC == EXPR_BCD)
+#include "bcd.h"
+#define EXPR_TEXT_SIZE		BCD_TEXT_SIZE	/* Size of the text of a number */
+
+#if (BCD_DECIMALS > FIXED_MAX_DECIMALS)
+#error "The BCD numbers of the functions are converted with FIXED_MAX_DECIMALS decimals at most"
+#endif
+#else
+#include "fixed.h"
+#include "fmt.h"
+#define EXPR_TEXT_SIZE		FMT_BUFFER_SIZE	/* Size of the text of a number */
+#define EXPR_DECIMALS		FIXED_MAX_DECIMALS	/* Maximum decimals of the text */
+#endif
+
+/*
+ * Maximum number of tokens (numbers and operators) in one expression, it bounds
+ * the memory and the evaluation time
+ */
+#define EXPR_MAX_TOKENS		16
+
+/*
+ * Operator of the integer power (x ^ n), it is calculated before the other
+ * operators and from right to left (2^3^2 = 2^9), n must be an integer and it
+ * takes 2 multiplications per bit of n at most
+ */
+#define EXPR_POWER		'^'
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* Numbers of the engine, the entered numbers are integers */
+#if (EXPR_ARITHMETIC == EXPR_BCD)
+typedef BCD_Type EXPR_NumberType;
+#else
+typedef FIXED_Type EXPR_NumberType;
+#endif
+
+typedef enum
+{
+	EXPR_OK, EXPR_ERROR_SYNTAX, EXPR_ERROR_FULL, EXPR_ERROR_OVERFLOW, EXPR_ERROR_DIVIDE_BY_ZERO,
+	EXPR_ERROR_MATH
+}EXPR_StatusType;
+
+/* Scientific functions of EXPR_function */
+typedef enum
+{
+	EXPR_SQRT, EXPR_SIN, EXPR_COS, EXPR_ATAN, EXPR_LOG2, EXPR_EXP2
+}EXPR_FunctionType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: EXPR_init
+ *
+ * [Description]: Function to start a new empty expression
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void EXPR_init(void);
+
+/*******************************************************************************
+ * [Function Name]: EXPR_digit
+ *
+ * [Description]: Function to add a digit to the number being entered
+ *
+ * [Args]:	  digit
+ *
+ * [in]		  digit: Unsigned Character (0 --> 9)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     EXPR_OK, EXPR_ERROR_SYNTAX if a number can not start here or
+ * 		  EXPR_ERROR_OVERFLOW if the number is too long (the digit is
+ * 		  ignored in both cases)
+ *******************************************************************************/
+EXPR_StatusType EXPR_digit(uint8 digit);
+
+/*******************************************************************************
+ * [Function Name]: EXPR_number
+ *
+ * [Description]: Function to add a complete number (the previous result for
+ * 		  example), no digit can follow it
+ *
+ * [Args]:	  Value_Ptr
+ *
+ * [in]		  Value_Ptr: Pointer to EXPR_NumberType
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     EXPR_OK or EXPR_ERROR_SYNTAX if a number can not start here
+ *******************************************************************************/
+EXPR_StatusType EXPR_number(const EXPR_NumberType * Value_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: EXPR_operator
+ *
+ * [Description]: Function to add an operator, a '-' where a number is expected
+ * 		  is the sign of the next number
+ *
+ * [Args]:	  op
+ *
+ * [in]		  op: Unsigned Character ('+', '-', '*', '/' or EXPR_POWER)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     EXPR_OK, EXPR_ERROR_SYNTAX if an operator can not be added
+ * 		  here or EXPR_ERROR_FULL if the expression has EXPR_MAX_TOKENS
+ * 		  tokens (the operator is ignored in both cases)
+ *******************************************************************************/
+EXPR_StatusType EXPR_operator(uint8 op);
+
+/*******************************************************************************
+ * [Function Name]: EXPR_evaluate
+ *
+ * [Description]: Function to calculate the expression, a new empty expression
+ * 		  is started after it whatever the result
+ *
+ * [Args]:	  Result_Ptr
+ *
+ * [in]		  None
+ *
+ * [out]	  Result_Ptr: Pointer to EXPR_NumberType
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     EXPR_OK or the error that stopped the calculation
+ *******************************************************************************/
+EXPR_StatusType EXPR_evaluate(EXPR_NumberType * Result_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: EXPR_format
+ *
+ * [Description]: Function to write a number in decimal without the zeros at
+ * 		  the end of its fraction
+ *
+ * [Args]:	  Str, Value_Ptr
+ *
+ * [in]		  Value_Ptr: Pointer to EXPR_NumberType
+ *
+ * [out]	  Str: Pointer to character (buffer of EXPR_TEXT_SIZE characters)
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     Number of characters written without the null terminator
+ *******************************************************************************/
+uint8 EXPR_format(char *Str,const EXPR_NumberType * Value_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: EXPR_function
+ *
+ * [Description]: Function to calculate a scientific function of a number (the
+ * 		  result of an expression for example) with the cordic module,
+ * 		  the angles are in radians
+ *
+ * [Args]:	  function, Value_Ptr, Result_Ptr
+ *
+ * [in]		  function: EXPR_FunctionType
+ * 		  Value_Ptr: Pointer to EXPR_NumberType
+ *
+ * [out]	  Result_Ptr: Pointer to EXPR_NumberType
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     EXPR_OK, EXPR_ERROR_OVERFLOW if the number or the result is
+ * 		  out of the fixed point range or EXPR_ERROR_MATH if the number
+ * 		  is out of the domain of the function
+ *******************************************************************************/
+EXPR_StatusType EXPR_function(EXPR_FunctionType function,const EXPR_NumberType * Value_Ptr,EXPR_NumberType * Result_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: EXPR_calculate
+ *
+ * [Description]: Function to calculate one operation between two numbers
+ * 		  outside of the expression (the memory register for example),
+ * 		  the result is written only if it is in range
+ *
+ * [Args]:	  op, a, b, Result_Ptr
+ *
+ * [in]		  op: Unsigned Character ('+', '-', '*', '/' or EXPR_POWER)
+ * 		  a, b: Pointer to EXPR_NumberType
+ *
+ * [out]	  Result_Ptr: Pointer to EXPR_NumberType
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     EXPR_OK, EXPR_ERROR_OVERFLOW or EXPR_ERROR_DIVIDE_BY_ZERO
+ *******************************************************************************/
+EXPR_StatusType EXPR_calculate(uint8 op,const EXPR_NumberType * a,const EXPR_NumberType * b,EXPR_NumberType * Result_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: EXPR_clear
+ *
+ * [Description]: Function to set a number to zero
+ *
+ * [Args]:	  Number_Ptr
+ *
+ * [in]		  None
+ *
+ * [out]	  Number_Ptr: Pointer to EXPR_NumberType
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void EXPR_clear(EXPR_NumberType * Number_Ptr);
+
+#endif /* EXPR_H_ */
@@ -0,0 +1,358 @@
+ /******************************************************************************
+ *
+ * [MODULE]: FIXED POINT
+ *
+ * [FILE NAME]: fixed.c
+ *
+ * [DESCRIPTION]: Source file for the 32-bit fixed point arithmetic
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include "fixed.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+#define FIXED_FRACTION_MASK	(((uint32)1 << FIXED_FRACTION_BITS) - 1)
+#define FIXED_HALF		((uint32)1 << (FIXED_FRACTION_BITS - 1))
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static const uint16 g_powersOf10[FIXED_MAX_DECIMALS + 1] = {1, 10, 100, 1000};
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for giving the signed result of a magnitude, saturated
+ * if it is out of the range
+ */
+static uint8 FIXED_saturate(uint32 magnitude,uint8 negative,FIXED_Type * Result_Ptr);
+
+/* Function responsible for returning the magnitude of a number */
+static uint32 FIXED_magnitude(FIXED_Type value);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: FIXED_fromInteger
+ *
+ * [Description]: Function to convert an integer to fixed point
+ *
+ * [Args]:	  value, Result_Ptr
+ *
+ * [in]		  value: Signed Long (integer to be converted)
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated
+ *******************************************************************************/
+uint8 FIXED_fromInteger(sint32 value,FIXED_Type * Result_Ptr)
+{
+	uint32 magnitude = FIXED_magnitude(value);
+
+	if(magnitude > (0xFFFFFFFFUL >> FIXED_FRACTION_BITS))
+	{
+		magnitude = 0xFFFFFFFFUL;	/* Saturated by FIXED_saturate */
+	}
+	else
+	{
+		magnitude <<= FIXED_FRACTION_BITS;
+	}
+	return FIXED_saturate(magnitude, (value < 0), Result_Ptr);
+}
+
+/*******************************************************************************
+ * [Function Name]: FIXED_add
+ *
+ * [Description]: Function to add two numbers (a + b)
+ *
+ * [Args]:	  a, b, Result_Ptr
+ *
+ * [in]		  a, b: FIXED_Type
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated
+ *******************************************************************************/
+uint8 FIXED_add(FIXED_Type a,FIXED_Type b,FIXED_Type * Result_Ptr)
+{
+	FIXED_Type result = (FIXED_Type)((uint32)a + (uint32)b);
+
+	/* The sum overflows only if both numbers have the same sign and the result has the other one */
+	if(((a ^ result) & (b ^ result)) < 0)
+	{
+		*Result_Ptr = (a < 0) ? FIXED_MIN : FIXED_MAX;
+		return FALSE;
+	}
+	*Result_Ptr = result;
+	return TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]: FIXED_sub
+ *
+ * [Description]: Function to subtract two numbers (a - b)
+ *
+ * [Args]:	  a, b, Result_Ptr
+ *
+ * [in]		  a, b: FIXED_Type
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated
+ *******************************************************************************/
+uint8 FIXED_sub(FIXED_Type a,FIXED_Type b,FIXED_Type * Result_Ptr)
+{
+	FIXED_Type result = (FIXED_Type)((uint32)a - (uint32)b);
+
+	/* The difference overflows only if the numbers have different signs and the result has the sign of (b) */
+	if(((a ^ b) & (a ^ result)) < 0)
+	{
+		*Result_Ptr = (a < 0) ? FIXED_MIN : FIXED_MAX;
+		return FALSE;
+	}
+	*Result_Ptr = result;
+	return TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]: FIXED_mul
+ *
+ * [Description]: Function to multiply two numbers (a * b), rounded half away
+ * 		  from zero
+ *
+ * [Args]:	  a, b, Result_Ptr
+ *
+ * [in]		  a, b: FIXED_Type
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated
+ *******************************************************************************/
+uint8 FIXED_mul(FIXED_Type a,FIXED_Type b,FIXED_Type * Result_Ptr)
+{
+	uint32 ua = FIXED_magnitude(a);
+	uint32 ub = FIXED_magnitude(b);
+	uint16 al = (uint16)ua;
+	uint16 ah = (uint16)(ua >> 16);
+	uint16 bl = (uint16)ub;
+	uint16 bh = (uint16)(ub >> 16);
+	uint32 low;
+	uint32 middle;
+	uint32 high;
+	uint32 temp;
+
+	/* 64-bit product (high:low) of the magnitudes from four 16 x 16 bit products */
+	low = (uint32)al * bl;
+	high = (uint32)ah * bh;
+
+	middle = (uint32)al * bh;
+	temp = (uint32)ah * bl;
+	middle += temp;
+	if(middle < temp)
+	{
+		high += (uint32)1 << 16;	/* Carry of the middle sum */
+	}
+
+	temp = low;
+	low += middle << 16;
+	high += (middle >> 16) + ((low < temp) ? 1 : 0);
+
+	/* Round, then remove the extra fraction bits */
+	temp = low;
+	low += FIXED_HALF;
+	if(low < temp)
+	{
+		high++;
+	}
+
+	if((high >> FIXED_FRACTION_BITS) != 0)
+	{
+		return FIXED_saturate(0xFFFFFFFFUL, ((a ^ b) < 0), Result_Ptr);
+	}
+	return FIXED_saturate((high << (32 - FIXED_FRACTION_BITS)) | (low >> FIXED_FRACTION_BITS), ((a ^ b) < 0), Result_Ptr);
+}
+
+/*******************************************************************************
+ * [Function Name]: FIXED_div
+ *
+ * [Description]: Function to divide two numbers (a / b), rounded half away
+ * 		  from zero, a division by zero saturates to the sign of (a)
+ *
+ * [Args]:	  a, b, Result_Ptr
+ *
+ * [in]		  a, b: FIXED_Type
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated
+ *******************************************************************************/
+uint8 FIXED_div(FIXED_Type a,FIXED_Type b,FIXED_Type * Result_Ptr)
+{
+	uint32 ua = FIXED_magnitude(a);
+	uint32 ub = FIXED_magnitude(b);
+	uint32 quotient;
+	uint32 remainder;
+	uint8 i;
+
+	if(ub == 0)
+	{
+		return FIXED_saturate(0xFFFFFFFFUL, (a < 0), Result_Ptr);
+	}
+
+	/* Integer part, then the fraction bits one by one (the remainder is always below ub <= 2^31) */
+	quotient = ua / ub;
+	remainder = ua - (quotient * ub);
+	if(quotient > ((uint32)1 << (31 - FIXED_FRACTION_BITS)))
+	{
+		return FIXED_saturate(0xFFFFFFFFUL, ((a ^ b) < 0), Result_Ptr);
+	}
+
+	for(i = 0; i < FIXED_FRACTION_BITS; i++)
+	{
+		remainder <<= 1;
+		quotient <<= 1;
+		if(remainder >= ub)
+		{
+			remainder -= ub;
+			quotient |= 1;
+		}
+	}
+
+	/* Round up if the remainder is at least half of the divisor */
+	if(remainder >= (ub - remainder))
+	{
+		quotient++;
+	}
+
+	return FIXED_saturate(quotient, ((a ^ b) < 0), Result_Ptr);
+}
+
+/*******************************************************************************
+ * [Function Name]: FIXED_toDecimal
+ *
+ * [Description]: Function to convert a number to decimal fixed point for the
+ * 		  FMT_fixed function, rounded half away from zero
+ *
+ * [Args]:	  value, decimals
+ *
+ * [in]		  value: FIXED_Type
+ * 		  decimals: Unsigned Character (0 --> FIXED_MAX_DECIMALS)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     The number multiplied by 10^decimals
+ *******************************************************************************/
+sint32 FIXED_toDecimal(FIXED_Type value,uint8 decimals)
+{
+	uint32 magnitude = FIXED_magnitude(value);
+	uint16 scale = g_powersOf10[decimals];
+	uint32 result;
+
+	result = (magnitude >> FIXED_FRACTION_BITS) * scale;
+	result += (((magnitude & FIXED_FRACTION_MASK) * scale) + FIXED_HALF) >> FIXED_FRACTION_BITS;
+
+	return (value < 0) ? -(sint32)result : (sint32)result;
+}
+
+/*******************************************************************************
+ * [Function Name]: FIXED_fromDecimal
+ *
+ * [Description]: Function to convert a decimal fixed point number (a number
+ * 		  multiplied by 10^decimals) to fixed point, rounded half away
+ * 		  from zero
+ *
+ * [Args]:	  value, decimals, Result_Ptr
+ *
+ * [in]		  value: Signed Long (the number multiplied by 10^decimals)
+ * 		  decimals: Unsigned Character (0 --> FIXED_MAX_DECIMALS)
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated
+ *******************************************************************************/
+uint8 FIXED_fromDecimal(sint32 value,uint8 decimals,FIXED_Type * Result_Ptr)
+{
+	uint32 magnitude = FIXED_magnitude(value);
+	uint16 scale = g_powersOf10[decimals];
+	uint32 integer = magnitude / scale;
+	uint16 remainder = (uint16)(magnitude - (integer * scale));
+	uint16 fraction = 0;
+	uint8 i;
+
+	if(integer > (0xFFFFFFFFUL >> FIXED_FRACTION_BITS))
+	{
+		return FIXED_saturate(0xFFFFFFFFUL, (value < 0), Result_Ptr);
+	}
+
+	/* Fraction bits of remainder / scale, one per step like FIXED_div (remainder < scale <= 1000) */
+	for(i = 0; i < FIXED_FRACTION_BITS; i++)
+	{
+		remainder <<= 1;
+		fraction <<= 1;
+		if(remainder >= scale)
+		{
+			remainder -= scale;
+			fraction |= 1;
+		}
+	}
+	if((remainder << 1) >= scale)
+	{
+		fraction++;	/* Rounded half away from zero, it can not carry into a new integer */
+	}
+
+	magnitude = (integer << FIXED_FRACTION_BITS) + fraction;
+	return FIXED_saturate(magnitude, (value < 0), Result_Ptr);
+}
+
+static uint8 FIXED_saturate(uint32 magnitude,uint8 negative,FIXED_Type * Result_Ptr)
+{
+	if(negative)
+	{
+		if(magnitude > 0x80000000UL)
+		{
+			*Result_Ptr = FIXED_MIN;
+			return FALSE;
+		}
+		*Result_Ptr = (FIXED_Type)(0 - magnitude);
+	}
+	else
+	{
+		if(magnitude > 0x7FFFFFFFUL)
+		{
+			*Result_Ptr = FIXED_MAX;
+			return FALSE;
+		}
+		*Result_Ptr = (FIXED_Type)magnitude;
+	}
+	return TRUE;
+}
+
+static uint32 FIXED_magnitude(FIXED_Type value)
+{
+	/* Negate in unsigned arithmetic so the most negative value is still correct */
+	return (value < 0) ? ((uint32)0 - (uint32)value) : (uint32)value;
+}
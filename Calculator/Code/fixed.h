@@ -0,0 +1,183 @@
+ /******************************************************************************
+ *
+ * [MODULE]: FIXED POINT
+ *
+ * [FILE NAME]: fixed.h
+ *
+ * [DESCRIPTION]: Header file for the 32-bit fixed point arithmetic, a number is
+ * 		  stored as a signed long multiplied by 2^FIXED_FRACTION_BITS,
+ * 		  the results are rounded to the nearest value and saturated to
+ * 		  the range instead of wrapping around, the multiplication uses
+ * 		  only 16-bit partial products and the division is bit serial so
+ * 		  neither the floating point nor the 64-bit library is linked
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef FIXED_H_
+#define FIXED_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/*
+ * Number of fraction bits (Q20.12 with 12): range +/-524287.999, resolution
+ * 1/4096 (0.00024), enough for 3 correct decimals
+ */
+#define FIXED_FRACTION_BITS	12
+
+#if (FIXED_FRACTION_BITS < 10) || (FIXED_FRACTION_BITS > 16)
+#error "FIXED_FRACTION_BITS must be 10 --> 16 for FIXED_toDecimal"
+#endif
+
+#define FIXED_ONE		((FIXED_Type)1 << FIXED_FRACTION_BITS)
+#define FIXED_MAX		((FIXED_Type)0x7FFFFFFFL)
+#define FIXED_MIN		(-FIXED_MAX - 1)
+
+/* Largest integer part */
+#define FIXED_MAX_INTEGER	(FIXED_MAX >> FIXED_FRACTION_BITS)
+
+/* Maximum number of decimals of FIXED_toDecimal */
+#define FIXED_MAX_DECIMALS	3
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef sint32 FIXED_Type;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: FIXED_fromInteger
+ *
+ * [Description]: Function to convert an integer to fixed point
+ *
+ * [Args]:	  value, Result_Ptr
+ *
+ * [in]		  value: Signed Long (integer to be converted)
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated
+ *******************************************************************************/
+uint8 FIXED_fromInteger(sint32 value,FIXED_Type * Result_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: FIXED_add
+ *
+ * [Description]: Function to add two numbers (a + b)
+ *
+ * [Args]:	  a, b, Result_Ptr
+ *
+ * [in]		  a, b: FIXED_Type
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated
+ *******************************************************************************/
+uint8 FIXED_add(FIXED_Type a,FIXED_Type b,FIXED_Type * Result_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: FIXED_sub
+ *
+ * [Description]: Function to subtract two numbers (a - b)
+ *
+ * [Args]:	  a, b, Result_Ptr
+ *
+ * [in]		  a, b: FIXED_Type
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated
+ *******************************************************************************/
+uint8 FIXED_sub(FIXED_Type a,FIXED_Type b,FIXED_Type * Result_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: FIXED_mul
+ *
+ * [Description]: Function to multiply two numbers (a * b), rounded half away
+ * 		  from zero
+ *
+ * [Args]:	  a, b, Result_Ptr
+ *
+ * [in]		  a, b: FIXED_Type
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated
+ *******************************************************************************/
+uint8 FIXED_mul(FIXED_Type a,FIXED_Type b,FIXED_Type * Result_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: FIXED_div
+ *
+ * [Description]: Function to divide two numbers (a / b), rounded half away
+ * 		  from zero, a division by zero saturates to the sign of (a)
+ *
+ * [Args]:	  a, b, Result_Ptr
+ *
+ * [in]		  a, b: FIXED_Type
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated
+ *******************************************************************************/
+uint8 FIXED_div(FIXED_Type a,FIXED_Type b,FIXED_Type * Result_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: FIXED_toDecimal
+ *
+ * [Description]: Function to convert a number to decimal fixed point for the
+ * 		  FMT_fixed function, rounded half away from zero
+ *
+ * [Args]:	  value, decimals
+ *
+ * [in]		  value: FIXED_Type
+ * 		  decimals: Unsigned Character (0 --> FIXED_MAX_DECIMALS)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     The number multiplied by 10^decimals
+ *******************************************************************************/
+sint32 FIXED_toDecimal(FIXED_Type value,uint8 decimals);
+
+/*******************************************************************************
+ * [Function Name]: FIXED_fromDecimal
+ *
+ * [Description]: Function to convert a decimal fixed point number (a number
+ * 		  multiplied by 10^decimals) to fixed point, rounded half away
+ * 		  from zero
+ *
+ * [Args]:	  value, decimals, Result_Ptr
+ *
+ * [in]		  value: Signed Long (the number multiplied by 10^decimals)
+ * 		  decimals: Unsigned Character (0 --> FIXED_MAX_DECIMALS)
+ *
+ * [out]	  Result_Ptr: Pointer to FIXED_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE, or FALSE if the result is saturated
+ *******************************************************************************/
+uint8 FIXED_fromDecimal(sint32 value,uint8 decimals,FIXED_Type * Result_Ptr);
+
+#endif /* FIXED_H_ */
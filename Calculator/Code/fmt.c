@@ -0,0 +1,233 @@
+ /******************************************************************************
+ *
+ * [MODULE]: FORMAT
+ *
+ * [FILE NAME]: fmt.c
+ *
+ * [DESCRIPTION]: Source file for the number formatting functions
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include "fmt.h"
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for dividing the value by 10 and returning the remainder
+ */
+static uint8 FMT_divideBy10(uint32 *value);
+
+/*
+ * Function responsible for writing the magnitude with its sign, decimal point
+ * and padding
+ */
+static uint8 FMT_write(char *Str,uint32 magnitude,uint8 negative,uint8 decimals,uint8 width,char pad);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: FMT_unsigned
+ *
+ * [Description]: Function to write an unsigned number in decimal
+ *
+ * [Args]:	  Str, value, width, pad
+ *
+ * [in]		  value: Unsigned Long (number to be written)
+ * 		  width: Unsigned Character (minimum number of characters, 0 for none)
+ * 		  pad: Character (FMT_PAD_SPACE or FMT_PAD_ZERO)
+ *
+ * [out]	  Str: Pointer to character (buffer of FMT_BUFFER_SIZE characters)
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     Number of characters written without the null terminator
+ *******************************************************************************/
+uint8 FMT_unsigned(char *Str,uint32 value,uint8 width,char pad)
+{
+	return FMT_write(Str, value, FALSE, 0, width, pad);
+}
+
+/*******************************************************************************
+ * [Function Name]: FMT_signed
+ *
+ * [Description]: Function to write a signed number in decimal
+ *
+ * [Args]:	  Str, value, width, pad
+ *
+ * [in]		  value: Signed Long (number to be written)
+ * 		  width: Unsigned Character (minimum number of characters, 0 for none)
+ * 		  pad: Character (FMT_PAD_SPACE or FMT_PAD_ZERO)
+ *
+ * [out]	  Str: Pointer to character (buffer of FMT_BUFFER_SIZE characters)
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     Number of characters written without the null terminator
+ *******************************************************************************/
+uint8 FMT_signed(char *Str,sint32 value,uint8 width,char pad)
+{
+	return FMT_fixed(Str, value, 0, width, pad);
+}
+
+/*******************************************************************************
+ * [Function Name]: FMT_fixed
+ *
+ * [Description]: Function to write a fixed point number in decimal, the value
+ * 		  is the number multiplied by 10^decimals (1234 with 2 decimals
+ * 		  is written as 12.34)
+ *
+ * [Args]:	  Str, value, decimals, width, pad
+ *
+ * [in]		  value: Signed Long (scaled number to be written)
+ * 		  decimals: Unsigned Character (digits after the decimal point)
+ * 		  width: Unsigned Character (minimum number of characters, 0 for none)
+ * 		  pad: Character (FMT_PAD_SPACE or FMT_PAD_ZERO)
+ *
+ * [out]	  Str: Pointer to character (buffer of FMT_BUFFER_SIZE characters)
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     Number of characters written without the null terminator
+ *******************************************************************************/
+uint8 FMT_fixed(char *Str,sint32 value,uint8 decimals,uint8 width,char pad)
+{
+	if(value < 0)
+	{
+		/* Negate in unsigned arithmetic so the most negative value is still correct */
+		return FMT_write(Str, (uint32)0 - (uint32)value, TRUE, decimals, width, pad);
+	}
+	return FMT_write(Str, (uint32)value, FALSE, decimals, width, pad);
+}
+
+/*******************************************************************************
+ * [Function Name]: FMT_hex
+ *
+ * [Description]: Function to write a number in upper case hexadecimal
+ *
+ * [Args]:	  Str, value, digits
+ *
+ * [in]		  value: Unsigned Long (number to be written)
+ * 		  digits: Unsigned Character (number of hex digits 1 --> 8)
+ *
+ * [out]	  Str: Pointer to character (buffer of FMT_BUFFER_SIZE characters)
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     Number of characters written without the null terminator
+ *******************************************************************************/
+uint8 FMT_hex(char *Str,uint32 value,uint8 digits)
+{
+	uint8 i;
+	uint8 nibble;
+
+	if(digits == 0 || digits > 8)
+	{
+		digits = 8;
+	}
+
+	/* Fill the buffer from the least significant nibble */
+	for(i = digits; i > 0; i--)
+	{
+		nibble = value & 0x0F;
+		Str[i - 1] = (nibble < 10) ? ('0' + nibble) : ('A' - 10 + nibble);
+		value >>= 4;
+	}
+	Str[digits] = '\0';
+
+	return digits;
+}
+
+static uint8 FMT_divideBy10(uint32 *value)
+{
+	uint32 n = *value;
+	uint32 q;
+	uint8 r;
+
+	if(n <= 0xFFFF)
+	{
+		/* 16-bit values: multiply by the reciprocal 0xCCCD / 2^19, exact for all 0 --> 65535 */
+		q = (n * 0xCCCDUL) >> 19;
+	}
+	else
+	{
+		/*
+		 * 32-bit values: approximate n * 0.8 with shifts and adds, divide by 8, then the
+		 * result is either exact or one less than the quotient so correct it once
+		 */
+		q = (n >> 1) + (n >> 2);
+		q += (q >> 4);
+		q += (q >> 8);
+		q += (q >> 16);
+		q >>= 3;
+	}
+
+	r = (uint8)(n - ((q << 3) + (q << 1)));	/* n - q*10 */
+	if(r > 9)
+	{
+		q++;
+		r -= 10;
+	}
+
+	*value = q;
+	return r;
+}
+
+static uint8 FMT_write(char *Str,uint32 magnitude,uint8 negative,uint8 decimals,uint8 width,char pad)
+{
+	char digits[10];	/* Digits in reverse order, a 32-bit number has 10 digits at most */
+	uint8 count = 0;
+	uint8 length;
+	uint8 i = 0;
+
+	if(decimals > FMT_MAX_DECIMALS)
+	{
+		decimals = FMT_MAX_DECIMALS;
+	}
+	if(width > FMT_MAX_WIDTH)
+	{
+		width = FMT_MAX_WIDTH;
+	}
+
+	/* Extract the digits, keep at least one digit before the decimal point */
+	do
+	{
+		digits[count++] = '0' + FMT_divideBy10(&magnitude);
+	}while((magnitude != 0) || (count <= decimals));
+
+	length = count + (negative ? 1 : 0) + (decimals ? 1 : 0);
+
+	/* Spaces go before the sign, zeros go after it */
+	if(pad != FMT_PAD_ZERO)
+	{
+		for(; length < width; length++)
+		{
+			Str[i++] = FMT_PAD_SPACE;
+		}
+	}
+	if(negative)
+	{
+		Str[i++] = '-';
+	}
+	for(; length < width; length++)
+	{
+		Str[i++] = FMT_PAD_ZERO;
+	}
+
+	while(count > 0)
+	{
+		if(count == decimals)
+		{
+			Str[i++] = '.';
+		}
+		Str[i++] = digits[--count];
+	}
+	Str[i] = '\0';
+
+	return i;
+}
@@ -1,10 +1,15 @@
  /******************************************************************************
  *
- * [Module]: KEYPAD
+ * [MODULE]: KEYPAD
  *
  * [FILE NAME]: keypad.h
  *
- * [DESCRIPTION]: Header file for the Keypad driver
+ * [DESCRIPTION]: Header file for the Keypad driver, the keypad is scanned one
+ * 		  column per tick into a bitmap of all the keys, the keys are
+ * 		  debounced together and their press/release edges are stored
+ * 		  in a small queue of key events, so keys pressed together are
+ * 		  all reported, a held key also gives long press and auto-repeat
+ * 		  events and two keys pressed together give a chord event
  *
  * [AUTHOR]: Ahmed Hassan
  *
@@ -28,15 +33,135 @@
 /* Keypad Port Configurations */
 #define KEYPAD_PORT_OUT PORTA
 #define KEYPAD_PORT_IN  PINA
-#define KEYPAD_PORT_DIR DDRA 
+#define KEYPAD_PORT_DIR DDRA
+
+/*
+ * Scan tick: KeyPad_scan must run every KEYPAD_TICK_TIME ms, one column is
+ * read each tick so the whole keypad is read every (N_col * KEYPAD_TICK_TIME) ms
+ */
+#define KEYPAD_TICK_TIME 1
+
+/* TIMER0 compare value of the tick with the F_CPU/64 prescaler */
+#define KEYPAD_TICK_COMPARE ((((F_CPU / 1000UL) * KEYPAD_TICK_TIME) / 64) - 1)
+
+/*
+ * Define it to let the driver generate the tick from the TIMER0 compare match
+ * interrupt, otherwise the application calls KeyPad_scan from its own timer
+ */
+#define KEYPAD_USE_TIMER0
+
+/*
+ * Number of whole keypad scans a key must keep its new state to be accepted (16 ms),
+ * fixed by the 2-bit debounce counters
+ */
+#define KEYPAD_DEBOUNCE_SCANS 4
+
+/*
+ * Define it to put the MCU in power-down while the application waits for a key and
+ * no key is pressed for KEYPAD_STANDBY_TIME ms, all the columns are driven low and
+ * any key pressed wakes the MCU through INT2, the rows must be connected to INT2/PB2
+ * through 4 diodes (cathodes to the rows)
+ */
+#undef KEYPAD_STANDBY
+#define KEYPAD_STANDBY_TIME 50
+
+/*
+ * Pin cleared before entering the standby and set when the first key after the wake
+ * up is accepted, the supply current is the standby current while it is low and the
+ * time from the key press to its rising edge is the wake-to-first-key latency
+ */
+#define KEYPAD_STANDBY_TEST_PORT PORTB
+#define KEYPAD_STANDBY_TEST_PORT_DIR DDRB
+#define KEYPAD_STANDBY_TEST_PIN PB0
+
+/*
+ * Key hold timing in ms (multiples of KEYPAD_TICK_TIME):
+ * KEYPAD_LONG_PRESS_TIME: a key held this long gives one KEYPAD_LONG_PRESSED event
+ * KEYPAD_REPEAT_DELAY, KEYPAD_REPEAT_PERIOD: default auto-repeat of a held key, a
+ * KEYPAD_REPEATED event after the delay then one every period (period 0: no repeat)
+ * KEYPAD_CHORD_TIME: a key pressed this soon after another one still held gives a
+ * KEYPAD_CHORD event of the two keys
+ */
+#define KEYPAD_LONG_PRESS_TIME 1000
+#define KEYPAD_REPEAT_DELAY 500
+#define KEYPAD_REPEAT_PERIOD 0
+#define KEYPAD_CHORD_TIME 100
+
+/* Key value of the second key of the events other than KEYPAD_CHORD */
+#define KEYPAD_NO_KEY 0xFF
+
+/* Number of entries in the key events queue (must be a power of 2) */
+#define KEYPAD_EVENTS_SIZE 8
+#define KEYPAD_EVENTS_MASK (KEYPAD_EVENTS_SIZE - 1)
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef enum
+{
+	KEYPAD_PRESSED, KEYPAD_RELEASED, KEYPAD_LONG_PRESSED, KEYPAD_REPEATED, KEYPAD_CHORD
+}KeyPad_EdgeType;
+
+typedef struct
+{
+	uint8 key;		/* Key value as returned by KeyPad_getPressedKey */
+	uint8 key2;		/* KEYPAD_CHORD only: key pressed while (key) was held */
+	KeyPad_EdgeType edge;
+	uint16 time;		/* Time of the event in ms (wraps around, stops in standby) */
+}KeyPad_EventType;
 
 /*******************************************************************************
  *                      Functions Prototypes                                   *
  *******************************************************************************/
 
 /*
- * Function responsible for getting the pressed keypad key
+ * Function responsible for initializing the keypad scanner (and the TIMER0 tick
+ * if KEYPAD_USE_TIMER0 is defined)
+ */
+void KeyPad_init(void);
+
+/*
+ * Function responsible for reading one column of the keypad, called every
+ * KEYPAD_TICK_TIME ms from the timer interrupt
+ */
+void KeyPad_scan(void);
+
+/*
+ * Function responsible for taking the oldest key event without waiting,
+ * returns TRUE if an event is taken, FALSE if the queue is empty
+ */
+uint8 KeyPad_poll(KeyPad_EventType * event);
+
+/*
+ * Function responsible for waiting the next key event of any type
+ */
+void KeyPad_waitEvent(KeyPad_EventType * event);
+
+/*
+ * Function responsible for waiting the next key press and returning its key
  */
 uint8 KeyPad_getPressedKey(void);
 
+/*
+ * Function responsible for changing the auto-repeat of a held key (times in ms,
+ * period 0 disables the repeat)
+ */
+void KeyPad_setRepeat(uint16 delay,uint16 period);
+
+/*
+ * Function responsible for checking if keys pressed on the corners of a rectangle
+ * hide the key on the fourth corner, new presses in these columns are ignored
+ * until one of the keys is released
+ */
+uint8 KeyPad_isGhosting(void);
+
+#ifdef KEYPAD_STANDBY
+/*
+ * Function responsible for putting the MCU in power-down until a key is pressed if
+ * the keypad is idle for KEYPAD_STANDBY_TIME ms, returns TRUE if the MCU slept
+ */
+uint8 KeyPad_standby(void);
+#endif
+
 #endif /* KEYPAD_H_ */
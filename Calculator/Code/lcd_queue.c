@@ -0,0 +1,444 @@
+ /******************************************************************************
+ *
+ * [MODULE]: LCD QUEUE
+ *
+ * [FILE NAME]: lcd_queue.c
+ *
+ * [DESCRIPTION]: Source file for the non-blocking LCD output queue
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include "lcd_queue.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Type of each queue entry */
+#define LCD_QUEUE_COMMAND	0
+#define LCD_QUEUE_DATA		1
+
+#if (LCD_TIMING_MODE == DELAY_TIMING)
+/* Ticks to wait after an entry, clear display and return home (0x01 --> 0x03) are long */
+#define LCD_QUEUE_CLEAR_HOME_TICKS	LCD_QUEUE_TICKS(LCD_CLEAR_HOME_TIME)
+#define LCD_QUEUE_EXECUTION_TICKS	LCD_QUEUE_TICKS(LCD_EXECUTION_TIME)
+#endif
+
+/*******************************************************************************
+ *                      Types Declaration                                      *
+ *******************************************************************************/
+
+typedef struct
+{
+	uint8 type;	/* LCD_QUEUE_COMMAND or LCD_QUEUE_DATA */
+	uint8 value;	/* Instruction or character */
+}LCD_QUEUE_EntryType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static volatile LCD_QUEUE_EntryType g_queue[LCD_QUEUE_SIZE];
+
+/*
+ * The foreground code only moves the head and the ISR only moves the tail,
+ * each index is a single byte so no critical section is needed
+ */
+static volatile uint8 g_queueHead = 0;
+static volatile uint8 g_queueTail = 0;
+
+#if (LCD_TIMING_MODE == DELAY_TIMING)
+/* Ticks left before the LCD finishes the last entry, used by the ISR only */
+static uint8 g_waitTicks = 0;
+#endif
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for returning the number of free entries in the queue
+ */
+static uint8 LCD_QUEUE_freeEntries(void);
+
+/*
+ * Function responsible for adding one entry to the queue
+ */
+static uint8 LCD_QUEUE_add(uint8 type,uint8 value);
+
+/*******************************************************************************
+ *                          ISR's Definitions                                  *
+ *******************************************************************************/
+
+ISR(TIMER2_COMP_vect)
+{
+	uint8 count = 0;
+	uint8 tail = g_queueTail;
+	uint8 value;
+
+#if (LCD_TIMING_MODE == DELAY_TIMING)
+	if(g_waitTicks != 0)
+	{
+		g_waitTicks--;	/* One more tick of the execution time elapsed */
+	}
+#endif
+
+	/*
+	 * Send the queued entries as long as the LCD can accept them, with the raw writes
+	 * of the driver so the ISR never waits for the LCD
+	 */
+	while((tail != g_queueHead) && (count < LCD_QUEUE_TICK_BURST))
+	{
+#if (LCD_TIMING_MODE == BUSY_FLAG_TIMING)
+		if(LCD_isBusy())
+		{
+			break;	/* Try again at the next tick */
+		}
+#elif (LCD_TIMING_MODE == DELAY_TIMING)
+		if(g_waitTicks != 0)
+		{
+			break;	/* The last entry is still executed */
+		}
+#endif
+
+		value = g_queue[tail].value;
+		if(g_queue[tail].type == LCD_QUEUE_COMMAND)
+		{
+			LCD_writeCommand(value);
+#if (LCD_TIMING_MODE == DELAY_TIMING)
+			g_waitTicks = (value <= 0x03) ? LCD_QUEUE_CLEAR_HOME_TICKS : LCD_QUEUE_EXECUTION_TICKS;
+#endif
+		}
+		else
+		{
+			LCD_writeData(value);
+#if (LCD_TIMING_MODE == DELAY_TIMING)
+			g_waitTicks = LCD_QUEUE_EXECUTION_TICKS;
+#endif
+		}
+
+		tail = (tail + 1) & LCD_QUEUE_MASK;
+		count++;
+	}
+
+	g_queueTail = tail;
+
+	/*
+	 * Nothing left to send or to wait for, the tick interrupt is disabled until
+	 * LCD_QUEUE_add queues the next entry, so an idle queue takes no CPU time
+	 */
+#if (LCD_TIMING_MODE == DELAY_TIMING)
+	if((tail == g_queueHead) && (g_waitTicks == 0))
+#else
+	if(tail == g_queueHead)
+#endif
+	{
+		CLEAR_BIT(TIMSK,OCIE2);
+	}
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_init
+ *
+ * [Description]: Function to empty the queue and start the TIMER2 service tick
+ * 		  (LCD must be initialized before), after this call all the
+ * 		  LCD output must go through the queue functions
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_QUEUE_init(void)
+{
+	g_queueHead = 0;
+	g_queueTail = 0;
+
+	TCNT2 = 0;				/* Set Timer initial value to 0 */
+	OCR2 = LCD_QUEUE_TICK_COMPARE;		/* Set Compare Value */
+	CLEAR_BIT(TIMSK,OCIE2);			/* Timer2 Compare Interrupt enabled by the first entry */
+
+	/*
+	 * Configure Timer2 control register:
+	 * 1. Non PWM mode FOC2=1
+	 * 2. CTC Mode WGM21=1 & WGM20=0
+	 * 3. No need for OC2 so COM21=0 & COM20=0
+	 * 4. Clock = F_CPU/8 CS22=0 CS21=1 CS20=0
+	 */
+	TCCR2 = (1<<FOC2) | (1<<WGM21) | (1<<CS21);
+
+	SREG |= (1<<7);				/* Enable interrupts by setting I-bit */
+}
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_sendCommand
+ *
+ * [Description]: Function to add an LCD instruction to the queue
+ *
+ * [Args]:	  command
+ *
+ * [in]		  command: Unsigned Character (LCD instruction)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the instruction is queued, FALSE if the queue is full
+ *******************************************************************************/
+uint8 LCD_QUEUE_sendCommand(uint8 command)
+{
+	return LCD_QUEUE_add(LCD_QUEUE_COMMAND, command);
+}
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_displayCharacter
+ *
+ * [Description]: Function to add a character to the queue
+ *
+ * [Args]:	  data
+ *
+ * [in]		  data: Unsigned Character (character to be displayed)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the character is queued, FALSE if the queue is full
+ *******************************************************************************/
+uint8 LCD_QUEUE_displayCharacter(uint8 data)
+{
+	return LCD_QUEUE_add(LCD_QUEUE_DATA, data);
+}
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_displayString
+ *
+ * [Description]: Function to add a whole string to the queue, nothing is queued
+ * 		  if the string does not fit in the free entries
+ *
+ * [Args]:	  Str
+ *
+ * [in]		  Str: Pointer to character (string to be displayed)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the string is queued, FALSE if the queue is full
+ *******************************************************************************/
+uint8 LCD_QUEUE_displayString(const char *Str)
+{
+	uint8 i = 0;
+
+	while(Str[i] != '\0')
+	{
+		i++;
+		if(i > LCD_QUEUE_freeEntries())
+		{
+			return FALSE;
+		}
+	}
+
+	for(i = 0; Str[i] != '\0'; i++)
+	{
+		LCD_QUEUE_add(LCD_QUEUE_DATA, Str[i]);
+	}
+
+	return TRUE;
+}
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_goToRowColumn
+ *
+ * [Description]: Function to add a cursor move to the queue
+ *
+ * [Args]:	  row, col
+ *
+ * [in]		  row: Unsigned Character (required row)
+ * 		  col: Unsigned Character (required column)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the cursor move is queued, FALSE if the queue is full
+ *******************************************************************************/
+uint8 LCD_QUEUE_goToRowColumn(uint8 row,uint8 col)
+{
+	return LCD_QUEUE_add(LCD_QUEUE_COMMAND, LCD_getRowColumnAddress(row,col) | SET_CURSOR_LOCATION);
+}
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_displayStringRowColumn
+ *
+ * [Description]: Function to add a cursor move followed by a string to the
+ * 		  queue, nothing is queued if both of them do not fit
+ *
+ * [Args]:	  row, col, Str
+ *
+ * [in]		  row: Unsigned Character (row of the first character)
+ * 		  col: Unsigned Character (column of the first character)
+ * 		  Str: Pointer to character (string to be displayed)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the output is queued, FALSE if the queue is full
+ *******************************************************************************/
+uint8 LCD_QUEUE_displayStringRowColumn(uint8 row,uint8 col,const char *Str)
+{
+	uint8 length = 0;
+
+	while(Str[length] != '\0')
+	{
+		length++;
+	}
+
+	/* One entry for the cursor move and one entry for each character */
+	if(length >= LCD_QUEUE_freeEntries())
+	{
+		return FALSE;
+	}
+
+	LCD_QUEUE_goToRowColumn(row,col);
+	return LCD_QUEUE_displayString(Str);
+}
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_intgerToString
+ *
+ * [Description]: Function to add the decimal digits of an integer to the queue
+ *
+ * [Args]:	  data
+ *
+ * [in]		  data: Integer (number to be displayed)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the number is queued, FALSE if the queue is full
+ *******************************************************************************/
+uint8 LCD_QUEUE_intgerToString(int data)
+{
+	char buff[FMT_BUFFER_SIZE]; /* String to hold the ASCII result */
+	FMT_signed(buff,data,0,FMT_PAD_SPACE); /* Decimal without padding */
+	return LCD_QUEUE_displayString(buff);
+}
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_clearScreen
+ *
+ * [Description]: Function to add the clear display instruction to the queue
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the instruction is queued, FALSE if the queue is full
+ *******************************************************************************/
+uint8 LCD_QUEUE_clearScreen(void)
+{
+	return LCD_QUEUE_add(LCD_QUEUE_COMMAND, CLEAR_COMMAND);
+}
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_isFlushDone
+ *
+ * [Description]: Function to check if all the queued output reached the LCD
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the queue is empty, FALSE otherwise
+ *******************************************************************************/
+uint8 LCD_QUEUE_isFlushDone(void)
+{
+	if(g_queueHead == g_queueTail)
+	{
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_waitFreeEntries
+ *
+ * [Description]: Function to wait until the ISR sent enough entries to the LCD
+ * 		  for the next output to be queued, it must not be called with
+ * 		  the interrupts disabled (the queue would never be emptied)
+ *
+ * [Args]:	  count
+ *
+ * [in]		  count: Unsigned Character (entries needed, a cursor move and
+ * 			 each character take one entry, not more than
+ * 			 LCD_QUEUE_SIZE - 1)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_QUEUE_waitFreeEntries(uint8 count)
+{
+	while(LCD_QUEUE_freeEntries() < count)
+	{
+		/* The TIMER2 ISR frees up to LCD_QUEUE_TICK_BURST entries per tick */
+	}
+}
+
+static uint8 LCD_QUEUE_freeEntries(void)
+{
+	/* One entry is always left empty to distinguish a full queue from an empty one */
+	return (LCD_QUEUE_SIZE - 1) - ((g_queueHead - g_queueTail) & LCD_QUEUE_MASK);
+}
+
+static uint8 LCD_QUEUE_add(uint8 type,uint8 value)
+{
+	uint8 head = g_queueHead;
+	uint8 next = (head + 1) & LCD_QUEUE_MASK;
+	uint8 sreg;
+
+	if(next == g_queueTail)
+	{
+		return FALSE;	/* Queue is full, the entry is dropped */
+	}
+
+	g_queue[head].type = type;
+	g_queue[head].value = value;
+	g_queueHead = next;	/* Publish the entry to the ISR after it is written */
+
+	/*
+	 * Start the tick again after the entry is published: an ISR that ran before saw
+	 * the entry or disabled the tick before this write, TIMSK is changed with the
+	 * interrupts disabled as it is not a bit addressable register
+	 */
+	sreg = SREG;
+	SREG &= ~(1<<7);
+	SET_BIT(TIMSK,OCIE2);
+	SREG = sreg;
+
+	return TRUE;
+}
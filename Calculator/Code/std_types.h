@@ -13,6 +13,8 @@
 #ifndef STD_TYPES_H_
 #define STD_TYPES_H_
 
+#include <stdint.h>
+
 /* Boolean Data Type */
 typedef unsigned char bool;
 
@@ -27,12 +29,16 @@ typedef unsigned char bool;
 #define HIGH        (1u)
 #define LOW         (0u)
 
+/*
+ * uint32/sint32 come from stdint.h so they are 32 bits on a PC too (a long is 64
+ * bits there) and the calculator core gives the same results in its host build
+ */
 typedef unsigned char         uint8;          /*           0 .. 255             */
 typedef signed char           sint8;          /*        -128 .. +127            */
 typedef unsigned short        uint16;         /*           0 .. 65535           */
 typedef signed short          sint16;         /*      -32768 .. +32767          */
-typedef unsigned long         uint32;         /*           0 .. 4294967295      */
-typedef signed long           sint32;         /* -2147483648 .. +2147483647     */
+typedef uint32_t              uint32;         /*           0 .. 4294967295      */
+typedef int32_t               sint32;         /* -2147483648 .. +2147483647     */
 typedef unsigned long long    uint64;         /*       0..18446744073709551615  */
 typedef signed long long      sint64;
 typedef float                 float32;
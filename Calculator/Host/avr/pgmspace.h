@@ -0,0 +1,26 @@
+ /******************************************************************************
+ *
+ * [MODULE]: CALCULATOR HOST
+ *
+ * [FILE NAME]: pgmspace.h
+ *
+ * [DESCRIPTION]: Host replacement of <avr/pgmspace.h>, the host has a single
+ * 		  address space so the flash reads are plain memory reads
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef HOST_AVR_PGMSPACE_H_
+#define HOST_AVR_PGMSPACE_H_
+
+#include <stdint.h>
+
+#define PROGMEM
+#define PSTR(s)			(s)
+#define pgm_read_byte(address)	(*(const uint8_t *)(address))
+#define pgm_read_word(address)	(*(const uint16_t *)(address))
+#define pgm_read_dword(address)	(*(const uint32_t *)(address))
+#define pgm_read_ptr(address)	(*(void * const *)(address))
+
+#endif /* HOST_AVR_PGMSPACE_H_ */
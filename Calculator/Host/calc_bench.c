@@ -0,0 +1,915 @@
+ /******************************************************************************
+ *
+ * [MODULE]: CALCULATOR HOST
+ *
+ * [FILE NAME]: calc_bench.c
+ *
+ * [DESCRIPTION]: Host program that runs the calculator core (calc, expr and the
+ * 		  arithmetic of expr.h) on random key sequences, it checks the
+ * 		  result row of every valid expression against an exact 128-bit
+ * 		  reference, checks the memory register and the history against
+ * 		  the same reference, feeds random garbage keys and functions to
+ * 		  check that the display and the store are never written out of
+ * 		  their bounds, and prints the evaluations per second with the
+ * 		  percentiles of the time of one key (time stamp counter cycles
+ * 		  on x86, nanoseconds elsewhere) over repeated runs, and on x86
+ * 		  the worst number of instructions of one key counted by single
+ * 		  stepping a sample of the sequences and the worst case ones
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "calc.h"
+
+/*
+ * The instructions of a key are counted by setting the trap flag of the x86, each
+ * instruction then raises SIGTRAP and the handler counts it. The count is the same at
+ * each run of the same binary (no interrupt, cache or frequency in it), unlike the
+ * times, so its maximum is a real worst case of the counted sequences. It counts PC
+ * instructions, not AVR cycles, it only ranks the keys and the changes of the core
+ */
+#if defined(__x86_64__)
+#include <signal.h>
+#define BENCH_COUNT_SUPPORTED	1
+#else
+#define BENCH_COUNT_SUPPORTED	0
+#endif
+
+/*
+ * Time of one key: the time stamp counter on x86 (cycles of the PC), the monotonic clock
+ * elsewhere (nanoseconds), neither is a count of AVR cycles
+ */
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_TICKS()		__rdtsc()
+#define BENCH_TICK_UNIT		"cycles"
+#else
+#define BENCH_TICKS()		BENCH_clock()
+#define BENCH_TICK_UNIT		"ns"
+#endif
+
+#if (EXPR_ARITHMETIC != EXPR_BCD)
+#error "The reference of calc_bench follows the BCD arithmetic (EXPR_ARITHMETIC = EXPR_BCD)"
+#endif
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Default number of random expressions and garbage keys */
+#define BENCH_EXPRESSIONS	1000000UL
+#define BENCH_GARBAGE_KEYS	1000000UL
+
+/* Operands of one expression (EXPR_MAX_TOKENS / 2) and digits of one operand */
+#define BENCH_MAX_OPERANDS	(EXPR_MAX_TOKENS / 2)
+#define BENCH_MAX_DIGITS	7
+
+/* The reference numbers are multiplied by 10^BCD_DECIMALS */
+#define BENCH_SCALE		1000
+#define BENCH_LIMIT		((__int128)100000000000000LL)	/* 10^BCD_DIGITS */
+
+/* Maximum number of keys of one expression (clear, digits, signs, operators and '=') */
+#define BENCH_MAX_KEYS		(BENCH_MAX_OPERANDS * (BENCH_MAX_DIGITS + 2) + 2)
+
+/*
+ * The expressions are timed in BENCH_RUNS runs with a histogram each, a percentile is
+ * stable from run to run when the interrupts and the cache misses of the PC are out of
+ * it, unlike the maximum. A bucket is BENCH_BUCKET_WIDTH ticks, the last one also
+ * counts all the longer keys
+ */
+#define BENCH_RUNS		5
+#define BENCH_BUCKET_WIDTH	8
+#define BENCH_BUCKETS		65536
+
+/* Percentile reported as the worst case, in 1/10000 (99.9 %) */
+#define BENCH_PERCENTILE	9990
+
+/*
+ * One expression and one garbage step out of BENCH_COUNT_EVERY are single stepped
+ * (a few hundred thousand instructions per second) instead of timed, the same ones at
+ * each run
+ */
+#define BENCH_COUNT_EVERY	10000
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef enum
+{
+	BENCH_OK, BENCH_OVERFLOW, BENCH_DIVIDE_BY_ZERO
+}BENCH_StatusType;
+
+/* Times of the keys of one run */
+typedef struct
+{
+	unsigned long counts[BENCH_BUCKETS];
+	unsigned long samples;
+}BENCH_HistogramType;
+
+/* Instructions of the counted keys */
+typedef struct
+{
+	unsigned long long worst;
+	unsigned long samples;
+}BENCH_CountType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Rows of the calculator display as the core writes them */
+static char g_rows[CALC_ROWS][CALC_LINE_WIDTH + 1];
+
+/* Characters written by the key being processed */
+static unsigned long g_written;
+
+/* Ticks of all the keys processed */
+static unsigned long long g_totalTicks = 0;
+
+/* Times of the keys of the current run (digits and operators, '='), of the garbage keys and of the functions */
+static BENCH_HistogramType g_keyTimes;
+static BENCH_HistogramType g_equalTimes;
+static BENCH_HistogramType g_garbageTimes;
+static BENCH_HistogramType g_functionTimes;
+
+/* Instructions of the counted keys (digits and operators, '='), and of the counted functions */
+static BENCH_CountType g_keyCounts;
+static BENCH_CountType g_equalCounts;
+static BENCH_CountType g_functionCounts;
+
+/* Instructions executed since the trap flag was set */
+static volatile unsigned long long g_steps = 0;
+
+/* The core wrote out of its rows */
+static int g_outOfRow = 0;
+
+/* Store of the core, it starts like an erased EEPROM */
+static CALC_StoreType g_store;
+
+/* Bytes of the store saved, and a save out of the store */
+static unsigned long g_savedBytes = 0;
+static int g_outOfStore = 0;
+
+static unsigned long long g_random = 88172645463325252ULL;
+
+/*
+ * Sequences of the deterministic worst case: the longest expressions of each operator
+ * and the divisions with the longest quotients (a division costs one pass per digit of
+ * its quotient, dividing by 3 or 7 never ends early), the longest one first
+ */
+static const char * const g_worstExpressions[] =
+{
+	"9999999/3/7/3/7/3/7/3",
+	"9999999/7/7/7/7/7/7/7",
+	"1234567/7/7/7/7/7/7/7",
+	"9999999/7+9999999/7+9999999/7+9999999/7",
+	"1/7+1/7+1/7+1/7+1/7+1/7+1/7+1/7",
+	"9999999+9999999+9999999+9999999+9999999+9999999+9999999+9999999",
+	"-9999999-9999999-9999999-9999999-9999999-9999999-9999999-9999999",
+	"9999999*9999999",
+	"1234567*7654321/9999999*1234567",
+	"2^2^2^2",
+	"9^9^9",
+};
+
+/* Operands of the functions */
+static const char * const g_worstOperands[] = {"9999999", "-9999999", "1234567", "7", "1", "0", "-1"};
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/* Function responsible for keeping the text written by the core (display call back) */
+static void BENCH_display(uint8 row,uint8 col,const char *Str);
+
+/* Function responsible for counting the saved bytes of the store (save call back) */
+static void BENCH_save(uint16 offset,uint16 size);
+
+/* Function responsible for checking the number entered by CALC_recall, returns the errors */
+static unsigned long BENCH_recall(uint8 index,const char *Expected);
+
+/* Function responsible for returning a random number 0 --> (range - 1) */
+static unsigned long BENCH_random(unsigned long range);
+
+/* Function responsible for calculating an operation of the reference with the BCD rounding */
+static BENCH_StatusType BENCH_apply(__int128 a,char op,__int128 b,__int128 *Result_Ptr);
+
+/* Function responsible for writing a reference number as the calculator does */
+static void BENCH_format(char *Str,__int128 value);
+
+/* Function responsible for processing a key and adding its time to a histogram */
+static void BENCH_key(uint8 key,BENCH_HistogramType *Times_Ptr);
+
+/* Function responsible for processing a key and adding its instructions to a count */
+static void BENCH_countKey(uint8 key,BENCH_CountType *Counts_Ptr);
+
+/* Function responsible for calculating a function and adding its instructions to a count */
+static void BENCH_countFunction(EXPR_FunctionType function,BENCH_CountType *Counts_Ptr);
+
+/* Function responsible for processing the worst case sequences with their instructions counted */
+static void BENCH_countWorstCases(void);
+
+/* Function responsible for typing an expression (digits, operators and '^') with its instructions counted */
+static void BENCH_countExpression(const char *Str);
+
+/* Function responsible for printing the worst instructions of a count */
+static void BENCH_printCount(const char *Name,const BENCH_CountType *Counts_Ptr);
+
+#if BENCH_COUNT_SUPPORTED
+/* Function responsible for counting one instruction (SIGTRAP handler) */
+static void BENCH_trap(int signal);
+
+/* Functions responsible for setting and clearing the trap flag, the steps between them are counted */
+static void BENCH_traceOn(void);
+static void BENCH_traceOff(void);
+#endif
+
+/* Function responsible for adding a time to a histogram */
+static void BENCH_addTime(BENCH_HistogramType *Times_Ptr,unsigned long long ticks);
+
+/* Function responsible for returning the time not exceeded by (perTenThousand / 100) % of the samples */
+static unsigned long long BENCH_percentile(const BENCH_HistogramType *Times_Ptr,unsigned long perTenThousand);
+
+/* Function responsible for printing the median, the lowest and the highest value of the runs */
+static void BENCH_printRuns(const char *Name,unsigned long long *Values);
+
+#if !(defined(__x86_64__) || defined(__i386__))
+/* Function responsible for reading the monotonic clock in nanoseconds */
+static unsigned long long BENCH_clock(void);
+#endif
+
+/* Function responsible for returning the text of a row without the spaces at its end */
+static void BENCH_row(char *Str,uint8 row);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(int argc,char *argv[])
+{
+	unsigned long expressions = (argc > 1) ? strtoul(argv[1], NULL, 0) : BENCH_EXPRESSIONS;
+	unsigned long garbage = (argc > 2) ? strtoul(argv[2], NULL, 0) : BENCH_GARBAGE_KEYS;
+	static const char operators[4] = {'+', '-', '*', '/'};
+	static const uint8 garbageKeys[] = {0,1,2,3,4,5,6,7,8,9,'+','-','*','/',CALC_KEY_POWER,'=',CALC_KEY_CLEAR,'%',0xFF};
+	char history[CALC_HISTORY_SIZE][EXPR_TEXT_SIZE];	/* Reference history, newest at historyNewest */
+	int historyNewest = CALC_HISTORY_SIZE - 1;
+	int historyCount = 0;
+	__int128 memory = 0;
+	unsigned long results = 0;
+	uint8 keys[BENCH_MAX_KEYS];
+	char typed[BENCH_MAX_KEYS + EXPR_TEXT_SIZE];
+	char expected[EXPR_TEXT_SIZE + 1];
+	char shown[CALC_LINE_WIDTH + 1];
+	__int128 previous = 0;
+	int previousValid = 0;
+	unsigned long long keyPercentile[BENCH_RUNS];		/* BENCH_PERCENTILE of each run */
+	unsigned long long equalPercentile[BENCH_RUNS];
+	unsigned long long keyMedian[BENCH_RUNS];
+	int run = 0;
+	unsigned long long ticks;
+	unsigned long worstWritten = 0;
+	unsigned long errors = 0;
+	unsigned long overflows = 0;
+	unsigned long divisions = 0;
+	unsigned long keyCount = 0;
+	unsigned long n;
+	struct timespec start, stop;
+	double seconds;
+
+#if BENCH_COUNT_SUPPORTED
+	signal(SIGTRAP, BENCH_trap);
+#endif
+	memset(&g_keyCounts, 0, sizeof(g_keyCounts));
+	memset(&g_equalCounts, 0, sizeof(g_equalCounts));
+	memset(&g_functionCounts, 0, sizeof(g_functionCounts));
+
+	memset(&g_store, 0xFF, sizeof(g_store));
+	CALC_init(BENCH_display, &g_store, BENCH_save);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	memset(&g_keyTimes, 0, sizeof(g_keyTimes));
+	memset(&g_equalTimes, 0, sizeof(g_equalTimes));
+	for(n = 0; n < expressions; n++)
+	{
+		/* Terms are multiplied/divided first, then added/subtracted from left to right */
+		__int128 sum = 0, term = 0, operand;
+		char sumOp = '+';
+		BENCH_StatusType status = BENCH_OK;
+		int operands = 1 + BENCH_random(BENCH_MAX_OPERANDS);
+		int keyLength = 0;
+		int typedLength = 0;
+		int chained = 0;
+		int i, d;
+
+		if(previousValid && (BENCH_random(3) == 0))
+		{
+			/* Continue with the last result, the first key is an operator */
+			chained = 1;
+			if(operands < 2)
+			{
+				operands = 2;
+			}
+			BENCH_format(typed, previous);
+			typedLength = strlen(typed);
+		}
+
+		for(i = 0; i < operands; i++)
+		{
+			char op = (i == 0) ? '+' : operators[BENCH_random(4)];
+
+			if((i == 0) && chained)
+			{
+				operand = previous;
+			}
+			else
+			{
+				int digits = 1 + BENCH_random(BENCH_MAX_DIGITS);
+				int negative = (BENCH_random(4) == 0);
+
+				if(i > 0)
+				{
+					keys[keyLength++] = op;
+					typed[typedLength++] = op;
+				}
+				else if(negative)
+				{
+					/* A '-' after a result would continue it, start a new expression */
+					keys[keyLength++] = CALC_KEY_CLEAR;
+				}
+				if(negative)
+				{
+					keys[keyLength++] = '-';
+					typed[typedLength++] = '-';
+				}
+				operand = 0;
+				for(d = 0; d < digits; d++)
+				{
+					uint8 digit = BENCH_random(10);
+					keys[keyLength++] = digit;
+					typed[typedLength++] = '0' + digit;
+					operand = operand * 10 + digit;
+				}
+				operand *= BENCH_SCALE;
+				if(negative)
+				{
+					operand = -operand;
+				}
+			}
+
+			if(status != BENCH_OK)
+			{
+				continue;
+			}
+
+			/* The first operand of a term, or the next factor of the current term */
+			if((i == 0) || (op == '+') || (op == '-'))
+			{
+				if(i > 0)
+				{
+					status = BENCH_apply(sum, sumOp, term, &sum);
+					sumOp = op;
+				}
+				term = operand;
+			}
+			else
+			{
+				status = BENCH_apply(term, op, operand, &term);
+			}
+		}
+		if(status == BENCH_OK)
+		{
+			status = BENCH_apply(sum, sumOp, term, &sum);
+		}
+		keys[keyLength++] = CALC_KEY_EQUAL;
+		typed[typedLength] = '\0';
+
+		switch(status)
+		{
+		case BENCH_OK:
+			expected[0] = '=';
+			BENCH_format(expected + 1, sum);
+			if(strlen(expected) > CALC_LINE_WIDTH)
+			{
+				memmove(expected, expected + 1, strlen(expected));
+			}
+			break;
+		case BENCH_OVERFLOW:
+			strcpy(expected, "=OVERFLOW");
+			overflows++;
+			break;
+		default:
+			strcpy(expected, "=DIVIDE BY ZERO");
+			divisions++;
+			break;
+		}
+
+		for(i = 0; i < keyLength; i++)
+		{
+			if((n % BENCH_COUNT_EVERY) == 0)
+			{
+				BENCH_countKey(keys[i], (keys[i] == CALC_KEY_EQUAL) ? &g_equalCounts : &g_keyCounts);
+			}
+			else
+			{
+				BENCH_key(keys[i], (keys[i] == CALC_KEY_EQUAL) ? &g_equalTimes : &g_keyTimes);
+			}
+			if(g_written > worstWritten)
+			{
+				worstWritten = g_written;
+			}
+
+			/* The expression row always shows the end of the typed text */
+			if(keys[i] == CALC_KEY_EQUAL)
+			{
+				BENCH_row(shown, CALC_ROW_EXPRESSION);
+				if((strlen(shown) > (size_t)typedLength) || (strcmp(typed + typedLength - strlen(shown), shown) != 0))
+				{
+					if(errors++ < 10)
+					{
+						printf("EXPRESSION ROW: typed \"%s\" shown \"%s\"\n", typed, shown);
+					}
+				}
+			}
+		}
+		keyCount += keyLength;
+
+		BENCH_row(shown, CALC_ROW_RESULT);
+		if(strcmp(shown, expected) != 0)
+		{
+			if(errors++ < 10)
+			{
+				printf("RESULT ROW: \"%s\" shown \"%s\" expected \"%s\"\n", typed, shown, expected);
+			}
+		}
+
+		previousValid = (status == BENCH_OK);
+		previous = sum;
+		if(status == BENCH_OK)
+		{
+			historyNewest = (historyNewest + 1) % CALC_HISTORY_SIZE;
+			BENCH_format(history[historyNewest], sum);
+			if(historyCount < CALC_HISTORY_SIZE)
+			{
+				historyCount++;
+			}
+			results++;
+
+			/* M+ or M- of the displayed result, the register is kept if it overflows */
+			if(BENCH_random(4) == 0)
+			{
+				char op = BENCH_random(2) ? '+' : '-';
+				__int128 updated;
+
+				CALC_memory((op == '+') ? CALC_MEMORY_ADD : CALC_MEMORY_SUBTRACT);
+				if(BENCH_apply(memory, op, sum, &updated) == BENCH_OK)
+				{
+					memory = updated;
+				}
+				else
+				{
+					previousValid = 0;	/* The error is displayed instead of the result */
+					BENCH_row(shown, CALC_ROW_RESULT);
+					if(strcmp(shown, "=MEMORY OVERFLOW") != 0)
+					{
+						if(errors++ < 10)
+						{
+							printf("MEMORY OVERFLOW: shown \"%s\"\n", shown);
+						}
+					}
+				}
+			}
+		}
+
+		/* Recall of the memory register or of a result of the history */
+		if(BENCH_random(8) == 0)
+		{
+			uint8 index = BENCH_random(CALC_HISTORY_SIZE + 2);
+
+			if(index == 0)
+			{
+				BENCH_format(expected, memory);
+			}
+			else if(index <= historyCount)
+			{
+				strcpy(expected, history[(historyNewest + CALC_HISTORY_SIZE + 1 - index) % CALC_HISTORY_SIZE]);
+			}
+			else
+			{
+				expected[0] = '\0';	/* Nothing is entered */
+			}
+			errors += BENCH_recall(index, expected);
+			previousValid = 0;
+		}
+		if(BENCH_random(64) == 0)
+		{
+			CALC_memory(CALC_MEMORY_CLEAR);
+			memory = 0;
+		}
+
+		/* End of a run: keep its percentiles and start the next histograms */
+		if((run < BENCH_RUNS) && ((n + 1) * BENCH_RUNS >= (unsigned long)(run + 1) * expressions))
+		{
+			keyMedian[run] = BENCH_percentile(&g_keyTimes, 5000);
+			keyPercentile[run] = BENCH_percentile(&g_keyTimes, BENCH_PERCENTILE);
+			equalPercentile[run] = BENCH_percentile(&g_equalTimes, BENCH_PERCENTILE);
+			memset(&g_keyTimes, 0, sizeof(g_keyTimes));
+			memset(&g_equalTimes, 0, sizeof(g_equalTimes));
+			run++;
+		}
+	}
+	for(; run < BENCH_RUNS; run++)
+	{
+		/* Less expressions than runs */
+		keyMedian[run] = 0;
+		keyPercentile[run] = 0;
+		equalPercentile[run] = 0;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+	seconds = (stop.tv_sec - start.tv_sec) + (stop.tv_nsec - start.tv_nsec) / 1e9;
+
+	printf("expressions        %lu (%lu overflows, %lu divisions by zero)\n", expressions, overflows, divisions);
+	printf("keys               %lu\n", keyCount);
+	printf("evaluations/s      %.0f\n", expressions / seconds);
+	printf("keys/s             %.0f\n", keyCount / seconds);
+	printf("%-19s%.0f\n", "mean " BENCH_TICK_UNIT "/key", (double)g_totalTicks / keyCount);
+	BENCH_printRuns("median " BENCH_TICK_UNIT "/key (digit or operator)", keyMedian);
+	BENCH_printRuns("p99.9 " BENCH_TICK_UNIT "/key (digit or operator)", keyPercentile);
+	BENCH_printRuns("p99.9 " BENCH_TICK_UNIT "/key ('=')", equalPercentile);
+	printf("worst chars/key    %lu\n", worstWritten);
+	printf("saved bytes/result %.1f (memory and history of %lu results)\n", (double)g_savedBytes / results, results);
+
+	/* The store is kept through a restart of the calculator (the EEPROM through a power off) */
+	CALC_init(BENCH_display, &g_store, BENCH_save);
+	BENCH_format(expected, memory);
+	errors += BENCH_recall(0, expected);
+	for(n = 1; n <= CALC_HISTORY_SIZE; n++)
+	{
+		errors += BENCH_recall(n, (n <= (unsigned long)historyCount) ? history[(historyNewest + CALC_HISTORY_SIZE + 1 - n) % CALC_HISTORY_SIZE] : "");
+	}
+
+	/* Any key in any order must keep the display inside its rows */
+	CALC_key(CALC_KEY_CLEAR);
+	memset(&g_garbageTimes, 0, sizeof(g_garbageTimes));
+	memset(&g_functionTimes, 0, sizeof(g_functionTimes));
+	for(n = 0; n < garbage; n++)
+	{
+		if(BENCH_random(32) == 0)
+		{
+			/* Memory operations and recalls in any state */
+			if(BENCH_random(2))
+			{
+				CALC_memory((CALC_MemoryType)BENCH_random(CALC_MEMORY_CLEAR + 1));
+			}
+			else
+			{
+				CALC_recall(BENCH_random(CALC_HISTORY_SIZE + 2));
+			}
+		}
+		else if(BENCH_random(16) == 0)
+		{
+			/* A function of the expression or of the result */
+			EXPR_FunctionType function = (EXPR_FunctionType)BENCH_random(EXPR_EXP2 + 1);
+
+			if((n % BENCH_COUNT_EVERY) == 0)
+			{
+				BENCH_countFunction(function, &g_functionCounts);
+			}
+			else
+			{
+				ticks = BENCH_TICKS();
+				CALC_function(function);
+				BENCH_addTime(&g_functionTimes, BENCH_TICKS() - ticks);
+			}
+		}
+		else if((n % BENCH_COUNT_EVERY) == 0)
+		{
+			uint8 key = garbageKeys[BENCH_random(sizeof(garbageKeys))];
+
+			BENCH_countKey(key, (key == CALC_KEY_EQUAL) ? &g_equalCounts : &g_keyCounts);
+		}
+		else
+		{
+			BENCH_key(garbageKeys[BENCH_random(sizeof(garbageKeys))], &g_garbageTimes);
+		}
+	}
+	printf("garbage keys       %lu, p99.9 " BENCH_TICK_UNIT "/key %llu, p99.9 " BENCH_TICK_UNIT "/function %llu\n", garbage,
+			BENCH_percentile(&g_garbageTimes, BENCH_PERCENTILE), BENCH_percentile(&g_functionTimes, BENCH_PERCENTILE));
+
+	/* Deterministic worst cases: the sampled sequences and the longest operations */
+	BENCH_countWorstCases();
+#if BENCH_COUNT_SUPPORTED
+	BENCH_printCount("worst instructions/key (digit or operator)", &g_keyCounts);
+	BENCH_printCount("worst instructions/key ('=')", &g_equalCounts);
+	BENCH_printCount("worst instructions/function", &g_functionCounts);
+#else
+	printf("worst instructions: not counted on this host (x86-64 only)\n");
+#endif
+
+	if(g_outOfRow)
+	{
+		printf("FAIL: text written out of the rows\n");
+		errors++;
+	}
+	if(g_outOfStore)
+	{
+		printf("FAIL: bytes saved out of the store\n");
+		errors++;
+	}
+	printf("%s: %lu errors\n", (errors == 0) ? "PASS" : "FAIL", errors);
+	return (errors == 0) ? 0 : 1;
+}
+
+static void BENCH_display(uint8 row,uint8 col,const char *Str)
+{
+	size_t length = strlen(Str);
+
+	if((row >= CALC_ROWS) || ((col + length) > CALC_LINE_WIDTH))
+	{
+		g_outOfRow = 1;
+		return;
+	}
+	memcpy(&g_rows[row][col], Str, length);
+	g_written += length;
+}
+
+static void BENCH_save(uint16 offset,uint16 size)
+{
+	if((size == 0) || ((offset + size) > sizeof(CALC_StoreType)))
+	{
+		g_outOfStore = 1;
+		return;
+	}
+	g_savedBytes += size;
+}
+
+static unsigned long BENCH_recall(uint8 index,const char *Expected)
+{
+	char shown[CALC_LINE_WIDTH + 1];
+
+	CALC_key(CALC_KEY_CLEAR);
+	CALC_recall(index);
+	BENCH_row(shown, CALC_ROW_EXPRESSION);
+	CALC_key(CALC_KEY_CLEAR);
+	if(strcmp(shown, Expected) != 0)
+	{
+		printf("RECALL %u: shown \"%s\" expected \"%s\"\n", index, shown, Expected);
+		return 1;
+	}
+	return 0;
+}
+
+static unsigned long BENCH_random(unsigned long range)
+{
+	g_random ^= g_random << 13;
+	g_random ^= g_random >> 7;
+	g_random ^= g_random << 17;
+	return (unsigned long)(g_random % range);
+}
+
+static BENCH_StatusType BENCH_apply(__int128 a,char op,__int128 b,__int128 *Result_Ptr)
+{
+	__int128 result;
+	__int128 magnitude;
+	int negative = 0;
+
+	switch(op)
+	{
+	case '+':
+		result = a + b;
+		break;
+	case '-':
+		result = a - b;
+		break;
+	case '*':
+		/* Rounded half away from zero */
+		magnitude = a * b;
+		negative = (magnitude < 0);
+		magnitude = negative ? -magnitude : magnitude;
+		result = (magnitude + BENCH_SCALE / 2) / BENCH_SCALE;
+		result = negative ? -result : result;
+		break;
+	default:
+		if(b == 0)
+		{
+			return BENCH_DIVIDE_BY_ZERO;
+		}
+		negative = ((a < 0) != (b < 0));
+		a = (a < 0) ? -a : a;
+		b = (b < 0) ? -b : b;
+		result = (a * BENCH_SCALE * 2 + b) / (b * 2);
+		result = negative ? -result : result;
+		break;
+	}
+
+	if((result >= BENCH_LIMIT) || (result <= -BENCH_LIMIT))
+	{
+		return BENCH_OVERFLOW;
+	}
+	*Result_Ptr = result;
+	return BENCH_OK;
+}
+
+static void BENCH_format(char *Str,__int128 value)
+{
+	unsigned long long magnitude = (value < 0) ? (unsigned long long)-value : (unsigned long long)value;
+	unsigned long long fraction = magnitude % BENCH_SCALE;
+	int length;
+
+	length = sprintf(Str, "%s%llu", (value < 0) ? "-" : "", magnitude / BENCH_SCALE);
+	if(fraction != 0)
+	{
+		length += sprintf(Str + length, ".%03llu", fraction);
+		while(Str[length - 1] == '0')
+		{
+			length--;
+		}
+		Str[length] = '\0';
+	}
+}
+
+static void BENCH_key(uint8 key,BENCH_HistogramType *Times_Ptr)
+{
+	unsigned long long ticks;
+
+	g_written = 0;
+	ticks = BENCH_TICKS();
+	CALC_key(key);
+	ticks = BENCH_TICKS() - ticks;
+	g_totalTicks += ticks;
+	BENCH_addTime(Times_Ptr, ticks);
+}
+
+static void BENCH_countKey(uint8 key,BENCH_CountType *Counts_Ptr)
+{
+#if BENCH_COUNT_SUPPORTED
+	g_written = 0;
+	g_steps = 0;
+	BENCH_traceOn();
+	CALC_key(key);
+	BENCH_traceOff();
+	if(g_steps > Counts_Ptr->worst)
+	{
+		Counts_Ptr->worst = g_steps;
+	}
+	Counts_Ptr->samples++;
+#else
+	(void)Counts_Ptr;
+	g_written = 0;
+	CALC_key(key);
+#endif
+}
+
+static void BENCH_countFunction(EXPR_FunctionType function,BENCH_CountType *Counts_Ptr)
+{
+#if BENCH_COUNT_SUPPORTED
+	g_steps = 0;
+	BENCH_traceOn();
+	CALC_function(function);
+	BENCH_traceOff();
+	if(g_steps > Counts_Ptr->worst)
+	{
+		Counts_Ptr->worst = g_steps;
+	}
+	Counts_Ptr->samples++;
+#else
+	(void)Counts_Ptr;
+	CALC_function(function);
+#endif
+}
+
+static void BENCH_countWorstCases(void)
+{
+	unsigned int i, f;
+
+	for(i = 0; i < sizeof(g_worstExpressions) / sizeof(g_worstExpressions[0]); i++)
+	{
+		BENCH_countExpression(g_worstExpressions[i]);
+		BENCH_countKey(CALC_KEY_EQUAL, &g_equalCounts);
+	}
+
+	/* Each function of a few operands, and of the longest expression (evaluated first) */
+	for(f = EXPR_SQRT; f <= EXPR_EXP2; f++)
+	{
+		for(i = 0; i < sizeof(g_worstOperands) / sizeof(g_worstOperands[0]); i++)
+		{
+			BENCH_countExpression(g_worstOperands[i]);
+			BENCH_countFunction((EXPR_FunctionType)f, &g_functionCounts);
+		}
+		BENCH_countExpression(g_worstExpressions[0]);
+		BENCH_countFunction((EXPR_FunctionType)f, &g_functionCounts);
+	}
+	BENCH_countKey(CALC_KEY_CLEAR, &g_keyCounts);
+}
+
+static void BENCH_countExpression(const char *Str)
+{
+	BENCH_countKey(CALC_KEY_CLEAR, &g_keyCounts);
+	for(; *Str != '\0'; Str++)
+	{
+		BENCH_countKey(((*Str >= '0') && (*Str <= '9')) ? (uint8)(*Str - '0') : (uint8)*Str, &g_keyCounts);
+	}
+}
+
+static void BENCH_printCount(const char *Name,const BENCH_CountType *Counts_Ptr)
+{
+	printf("%-38s %llu (%lu counted)\n", Name, Counts_Ptr->worst, Counts_Ptr->samples);
+}
+
+#if BENCH_COUNT_SUPPORTED
+static void BENCH_trap(int signal)
+{
+	(void)signal;
+	g_steps++;
+}
+
+/*
+ * Not inlined: pushfq writes below the stack pointer, in the red zone of a leaf function,
+ * these functions have no local data there. The instructions of BENCH_traceOff before
+ * the flag is cleared are counted too, the same number for every key
+ */
+static __attribute__((noinline)) void BENCH_traceOn(void)
+{
+	__asm__ volatile("pushfq\n\torq $0x100, (%%rsp)\n\tpopfq" ::: "memory", "cc");
+}
+
+static __attribute__((noinline)) void BENCH_traceOff(void)
+{
+	__asm__ volatile("pushfq\n\tandq $~0x100, (%%rsp)\n\tpopfq" ::: "memory", "cc");
+}
+#endif
+
+static void BENCH_addTime(BENCH_HistogramType *Times_Ptr,unsigned long long ticks)
+{
+	unsigned long long bucket = ticks / BENCH_BUCKET_WIDTH;
+
+	Times_Ptr->counts[(bucket < BENCH_BUCKETS) ? bucket : (BENCH_BUCKETS - 1)]++;
+	Times_Ptr->samples++;
+}
+
+static unsigned long long BENCH_percentile(const BENCH_HistogramType *Times_Ptr,unsigned long perTenThousand)
+{
+	/* Samples at or below the percentile, rounded up */
+	unsigned long long needed = ((unsigned long long)Times_Ptr->samples * perTenThousand + 9999) / 10000;
+	unsigned long long count = 0;
+	unsigned long bucket;
+
+	for(bucket = 0; bucket < BENCH_BUCKETS; bucket++)
+	{
+		count += Times_Ptr->counts[bucket];
+		if((count >= needed) && (count > 0))
+		{
+			break;
+		}
+	}
+	if(bucket == BENCH_BUCKETS)
+	{
+		return 0;	/* No sample */
+	}
+	return (unsigned long long)(bucket + 1) * BENCH_BUCKET_WIDTH;	/* Upper bound of the bucket */
+}
+
+static void BENCH_printRuns(const char *Name,unsigned long long *Values)
+{
+	unsigned long long sorted[BENCH_RUNS];
+	int i, j;
+
+	/* Insertion sort of the few runs */
+	for(i = 0; i < BENCH_RUNS; i++)
+	{
+		for(j = i; (j > 0) && (sorted[j - 1] > Values[i]); j--)
+		{
+			sorted[j] = sorted[j - 1];
+		}
+		sorted[j] = Values[i];
+	}
+	printf("%-38s %llu (runs %llu --> %llu)\n", Name, sorted[BENCH_RUNS / 2], sorted[0], sorted[BENCH_RUNS - 1]);
+}
+
+#if !(defined(__x86_64__) || defined(__i386__))
+static unsigned long long BENCH_clock(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((unsigned long long)now.tv_sec * 1000000000ULL) + now.tv_nsec;
+}
+#endif
+
+static void BENCH_row(char *Str,uint8 row)
+{
+	int length = CALC_LINE_WIDTH;
+
+	memcpy(Str, g_rows[row], CALC_LINE_WIDTH);
+	while((length > 0) && ((Str[length - 1] == ' ') || (Str[length - 1] == '\0')))
+	{
+		length--;
+	}
+	Str[length] = '\0';
+}
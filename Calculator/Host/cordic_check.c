@@ -0,0 +1,160 @@
+ /******************************************************************************
+ *
+ * [MODULE]: CALCULATOR HOST
+ *
+ * [FILE NAME]: cordic_check.c
+ *
+ * [DESCRIPTION]: Host program that measures the accuracy of the cordic module
+ * 		  against the C library, every fixed point argument of a range is
+ * 		  checked (1/4096 steps for FIXED_FRACTION_BITS 12) and the worst
+ * 		  error is printed in units of the last bit, the program fails if
+ * 		  an error is over the limit written in cordic.h
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include "cordic.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Arguments checked step by step (4 times more for sqrt and log2), the rest is sampled */
+#define CHECK_ANGLE_RANGE	(1024L * FIXED_ONE)
+
+/* Steps of the samples over the whole range of the fixed point numbers */
+#define CHECK_SAMPLE_STEP	997L
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	const char *name;
+	uint8 (*function)(FIXED_Type x,FIXED_Type * Result_Ptr);
+	double (*reference)(double x);
+	FIXED_Type first;	/* Arguments checked, all of them */
+	FIXED_Type last;
+	uint8 relative;		/* The error is relative to the result (exp2) */
+	double limit;		/* Largest error allowed, in last bits or relative */
+}CHECK_FunctionType;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/* Function responsible for checking one argument, returns the error */
+static double CHECK_error(const CHECK_FunctionType *Function_Ptr,FIXED_Type x);
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static const CHECK_FunctionType g_functions[] =
+{
+	{"sqrt", CORDIC_sqrt, sqrt, 0, CHECK_ANGLE_RANGE * 4, FALSE, 0.5},
+	{"sin", CORDIC_sin, sin, -CHECK_ANGLE_RANGE, CHECK_ANGLE_RANGE, FALSE, 1.0},
+	{"cos", CORDIC_cos, cos, -CHECK_ANGLE_RANGE, CHECK_ANGLE_RANGE, FALSE, 1.0},
+	{"atan", CORDIC_atan, atan, -CHECK_ANGLE_RANGE, CHECK_ANGLE_RANGE, FALSE, 1.0},
+	{"log2", CORDIC_log2, log2, 1, CHECK_ANGLE_RANGE * 4, FALSE, 1.0},
+	{"exp2", CORDIC_exp2, exp2, -(FIXED_FRACTION_BITS + 1) * FIXED_ONE, (31 - FIXED_FRACTION_BITS) * FIXED_ONE - 1, TRUE, 1.0 / 32768},
+};
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(void)
+{
+	unsigned long failures = 0;
+	unsigned int f;
+
+	for(f = 0; f < (sizeof(g_functions) / sizeof(g_functions[0])); f++)
+	{
+		const CHECK_FunctionType *function = &g_functions[f];
+		double worst = 0;
+		double error;
+		FIXED_Type worstX = 0;
+		sint64 x;
+
+		/* Every argument of the range, then samples of the whole fixed point range */
+		for(x = function->first; x <= function->last; x++)
+		{
+			error = CHECK_error(function, (FIXED_Type)x);
+			if(error > worst)
+			{
+				worst = error;
+				worstX = (FIXED_Type)x;
+			}
+		}
+		for(x = FIXED_MIN; x <= FIXED_MAX; x += CHECK_SAMPLE_STEP)
+		{
+			if((x < function->first) || (x > function->last))
+			{
+				if(((function->reference == log2) && (x <= 0)) || ((function->reference == sqrt) && (x < 0)))
+				{
+					continue;	/* Outside the domain, checked below */
+				}
+				if((function->reference == exp2) && (x > function->last))
+				{
+					continue;	/* Saturated, checked below */
+				}
+				error = CHECK_error(function, (FIXED_Type)x);
+				if(error > worst)
+				{
+					worst = error;
+					worstX = (FIXED_Type)x;
+				}
+			}
+		}
+
+		if(function->relative)
+		{
+			printf("%-5s worst relative error 2^%.2f at x = %.6f\n", function->name, log2(worst), (double)worstX / FIXED_ONE);
+		}
+		else
+		{
+			printf("%-5s worst error %.3f last bits at x = %.6f\n", function->name, worst, (double)worstX / FIXED_ONE);
+		}
+		if(worst > function->limit)
+		{
+			printf("FAIL: %s is over its limit\n", function->name);
+			failures++;
+		}
+	}
+
+	/* Arguments outside the domain or the range of the results */
+	{
+		FIXED_Type result;
+
+		if(CORDIC_sqrt(-1, &result) || CORDIC_log2(0, &result) || CORDIC_log2(FIXED_MIN, &result) ||
+		   CORDIC_exp2((31 - FIXED_FRACTION_BITS) * FIXED_ONE, &result) || (result != FIXED_MAX))
+		{
+			printf("FAIL: domain or saturation not reported\n");
+			failures++;
+		}
+	}
+
+	printf("%s\n", (failures == 0) ? "PASS" : "FAIL");
+	return (failures == 0) ? 0 : 1;
+}
+
+static double CHECK_error(const CHECK_FunctionType *Function_Ptr,FIXED_Type x)
+{
+	FIXED_Type result;
+	double exact = Function_Ptr->reference((double)x / FIXED_ONE);
+	double error;
+
+	Function_Ptr->function(x, &result);
+	if(Function_Ptr->relative)
+	{
+		/* Error over the rounding of the result to the last bit, relative to the result */
+		error = fabs((double)result - (exact * FIXED_ONE)) - 0.5;
+		return (error > 0) ? (error / (exact * FIXED_ONE)) : 0;
+	}
+	return fabs((double)result - (exact * FIXED_ONE));
+}
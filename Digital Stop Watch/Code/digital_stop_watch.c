@@ -13,7 +13,29 @@
  *	 	 - AVR MCU ATmega 16 (F_CPU = 1 MHZ).
  *		 - SW1 -> INT0 "Internal pull up Resistor" (Falling Edge)  -> (Reset Watch).
  *		 - SW2 -> INT1 "Pull up Resistor"          (Raising Edge)  -> (Pause Watch).
- *	         - SW3 -> INT2 "Internal pull up Resistor" (Falling Edge)  -> (Resume Watch).
+ *	         - SW3 -> INT2 "Internal pull up Resistor" (Falling Edge)  -> (Resume Watch,
+ *		                                                               or Lap when running).
+ *		 - SW4 -> PD4  "Internal pull up Resistor" (Polled)        -> (Next Display Page).
+ *
+ * Note: The 6 multiplexed 7-Segments are refreshed by the Timer 0 compare interrupt
+ * (display module), one digit per tick with a dead time between the digits, so the
+ * refresh rate (DISPLAY_REFRESH_RATE) is kept whatever the main loop does.
+ *
+ * Note: The time is counted in packed BCD (timer1 module), each digit is a nibble so
+ * the display needs no division. The 4 numbers are copied together with a sequence
+ * counter (snapshot module): a copy split by a tick is done again, so the display never
+ * shows a torn time (00:59 -> 01:59) and the interrupts are never disabled to read it.
+ *
+ * Note: Timer 1 uses the prescaler and compare value fitting F_CPU (F_CPU/1 and 10000
+ * counts per 10 ms at 1 MHz), and a fractional correction keeps the mean tick exact
+ * when F_CPU is not a multiple of the prescaler. TIMER1_TRIM (or Timer1_SetTrim)
+ * corrects the error of the crystal.
+ *
+ * Note: The time is counted in centiseconds and displayed as MM SS cc, or HH MM SS from
+ * one hour. SW3 while running records a lap (split time) in a ring buffer of LAP_SIZE
+ * laps. SW4 pages from the running time to the laps, newest first, the number of the
+ * lap is shown alone for LAP_NUMBER_TIME before its split time. Without SW4
+ * (SW4_FITTED 0, the Proteus schematic) the pages change every AUTO_PAGE_TIME.
  *
  ***********************************************************************************************/
 
@@ -22,6 +44,35 @@
 #include "interrupt.h"
 #include "timer1.h"
 
+/*****************************************************************************************
+ *                              Preprocessor Macros                                      *
+ *****************************************************************************************/
+
+/* Period of the main loop in ms, SW3 and SW4 are polled at this rate */
+#define LOOP_TIME 10
+
+/*
+ * SW4 on PD4 is not in the Proteus schematic yet: 0 pages the laps by themselves so
+ * they can be seen in the simulation, 1 when SW4 is wired to PD4
+ */
+#define SW4_FITTED 0
+
+/* SW4 must be read pressed for this number of loops to give one page */
+#define SW4_PRESS_POLLS 3
+
+/* Loops each page is displayed when SW4 is not fitted (only while laps are kept) */
+#define AUTO_PAGE_TIME (2000 / LOOP_TIME)
+
+/* Loops showing the number of the lap when a lap page is selected */
+#define LAP_NUMBER_TIME (500 / LOOP_TIME)
+
+/*****************************************************************************************
+ *                          Functions Prototypes(Private)                                *
+ *****************************************************************************************/
+
+/* Function responsible for displaying a time, as MM SS cc or as HH MM SS from one hour */
+static void Display_Time(const Time_Type *Time_Ptr);
+
 /*****************************************************************************************
  *                                MAIN FUNCTION                                          *
  *****************************************************************************************/
@@ -32,6 +83,16 @@ int main(void)
 	 *                           SYSTEM INITIALIZATION                              *
 	 ********************************************************************************/
 
+	Time_Type time;			/* Copy of the time or of a lap, packed BCD */
+	unsigned char page = 0;		/* 0 for the running time, n for the lap n (1 the last one) */
+#if SW4_FITTED
+	unsigned char pressed = 0;	/* Loops with SW4 pressed */
+#else
+	unsigned char pageTime = 0;	/* Loops the page has been displayed */
+#endif
+	unsigned char numberTime = 0;	/* Loops left showing the number of the lap */
+	unsigned char digit;
+
 	SREG |= (1<<7);		/* Enable interrupts by setting I-bit */
 
 	/* Interrupts Initialization */
@@ -39,13 +100,14 @@ int main(void)
 	INT1_Init();
 	INT2_Init();
 
-	Timer1_CTC_Init(1000); /* Start Counter to count 1 Second */
+#if SW4_FITTED
+	DDRD &= ~(1<<PD4);	/* Configure SW4/PD4 as input pin */
+	PORTD |= (1<<PD4);	/* Enable the internal pull up resistor at PD4 */
+#endif
 
-	DDRC = 0x0F;	       /* Configure First 4 pins in PORTC as output pins */
-	DDRA = 0x3F;	       /* Configure First 5 pins in PORTA as output pins */
+	Timer1_CTC_Init();     /* Start Counter to count the centiseconds */
 
-	PORTC = PORTC & 0xF0;  /* Set First 4 pins in PORTC with value 0 at the beginning (LEDs OFF) */
-	PORTA = PORTA & 0xC0;  /* Set First 5 pins in PORTA with value 0 to disable All 7-Segments */
+	SevenSegment_Init();   /* Start the refresh of the 6 multiplexed 7-Segments by Timer 0 */
 
 	while(1)
 	{
@@ -53,24 +115,86 @@ int main(void)
 		 *                   		    APPLICATION CODE              	        *
 		 ********************************************************************************/
 
-		PORTA = 0x01;	  /* Enable First 7-segment and disable others */
-		SevenSegment_Display(seconds%10);	/* Display Seconds from 0 -> 9 */
-		_delay_ms(3);
-		PORTA = 0x02;	  /* Enable Second 7-segment and disable others */
-		SevenSegment_Display(seconds/10);	/* Display Seconds from 10 -> 59 */
-		_delay_ms(3);
-		PORTA = 0x04;	  /* Enable Third 7-segment and disable others */
-		SevenSegment_Display(minutes%10);	/* Display Minutes from 0 -> 9 */
-		_delay_ms(3);
-		PORTA = 0x08;	  /* Enable Fourth 7-segment and disable others */
-		SevenSegment_Display(minutes/10);	/* Display Minutes from 10 -> 59 */
-		_delay_ms(3);
-		PORTA = 0x10;	  /* Enable Fifth 7-segment and disable others */
-		SevenSegment_Display(hours%10);	    /* Display Hours from 0 -> 9 */
-		_delay_ms(3);
-		PORTA = 0x20;	  /* Enable Sixth 7-segment and disable others */
-		SevenSegment_Display(hours/10);	  	/* Display Hours from 10 -> 23 */
-		_delay_ms(3);
+		INT2_Debounce();	/* SW3 gives one lap per press */
 
+#if SW4_FITTED
+		/* SW4 selects the next page, once per press */
+		if(!(PIND & (1<<PD4)))
+		{
+			if(pressed < SW4_PRESS_POLLS)
+			{
+				pressed++;
+				if(pressed == SW4_PRESS_POLLS)
+				{
+					page++;
+					numberTime = LAP_NUMBER_TIME;
+				}
+			}
+		}
+		else
+		{
+			pressed = 0;
+		}
+#else
+		/* Without SW4 the running time and the laps follow each other */
+		pageTime++;
+		if((pageTime >= AUTO_PAGE_TIME) && (Lap_GetCount() > 0))
+		{
+			pageTime = 0;
+			page++;
+			numberTime = LAP_NUMBER_TIME;
+		}
+#endif
+		if(page > Lap_GetCount())
+		{
+			page = 0;	/* After the last lap, or the laps were reset */
+		}
+
+		/* The digits are displayed by the Timer 0 interrupt, the loop only updates them */
+		if(page == 0)
+		{
+			Timer1_GetTime(&time);
+			Display_Time(&time);
+		}
+		else if(numberTime > 0)
+		{
+			/* Number of the lap on the first digit, the others blank */
+			numberTime--;
+			SevenSegment_SetDigit(0, page);
+			for(digit = 1; digit < DISPLAY_DIGITS; digit++)
+			{
+				SevenSegment_SetDigit(digit, DISPLAY_BLANK);
+			}
+		}
+		else
+		{
+			Lap_Read(page - 1, &time);
+			Display_Time(&time);
+		}
+
+		_delay_ms(LOOP_TIME);
+	}
+}
+
+static void Display_Time(const Time_Type *Time_Ptr)
+{
+	/* The time is packed BCD, each digit is a nibble (no division) */
+	if(Time_Ptr->hours == 0)
+	{
+		SevenSegment_SetDigit(0, Time_Ptr->centiseconds & 0x0F);	/* Display Centiseconds from 0 -> 9 */
+		SevenSegment_SetDigit(1, Time_Ptr->centiseconds >> 4);	/* Display Centiseconds from 10 -> 99 */
+		SevenSegment_SetDigit(2, Time_Ptr->seconds & 0x0F);	/* Display Seconds from 0 -> 9 */
+		SevenSegment_SetDigit(3, Time_Ptr->seconds >> 4);	/* Display Seconds from 10 -> 59 */
+		SevenSegment_SetDigit(4, Time_Ptr->minutes & 0x0F);	/* Display Minutes from 0 -> 9 */
+		SevenSegment_SetDigit(5, Time_Ptr->minutes >> 4);	/* Display Minutes from 10 -> 59 */
+	}
+	else
+	{
+		SevenSegment_SetDigit(0, Time_Ptr->seconds & 0x0F);	/* Display Seconds from 0 -> 9 */
+		SevenSegment_SetDigit(1, Time_Ptr->seconds >> 4);	/* Display Seconds from 10 -> 59 */
+		SevenSegment_SetDigit(2, Time_Ptr->minutes & 0x0F);	/* Display Minutes from 0 -> 9 */
+		SevenSegment_SetDigit(3, Time_Ptr->minutes >> 4);	/* Display Minutes from 10 -> 59 */
+		SevenSegment_SetDigit(4, Time_Ptr->hours & 0x0F);	/* Display Hours from 0 -> 9 */
+		SevenSegment_SetDigit(5, Time_Ptr->hours >> 4);		/* Display Hours from 10 -> 23 */
 	}
 }
@@ -11,18 +11,98 @@
  ******************************************************************************************/
 
 #include "display.h"
+#include <avr/pgmspace.h>
+
+/******************************************************************************************
+ *                                    Global Variables                                    *
+ ******************************************************************************************/
+
+/*
+ * Code written on the data pins for each value (0 --> 15), the pins drive the BCD input
+ * of the 7-Segment decoder so a digit is its own code and the values 10 --> 15 give the
+ * code 15 which turns all the segments off on the decoder
+ */
+static const unsigned char g_segmentCodes[16] PROGMEM =
+{
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09,
+	DISPLAY_BLANK, DISPLAY_BLANK, DISPLAY_BLANK, DISPLAY_BLANK, DISPLAY_BLANK, DISPLAY_BLANK
+};
+
+/*
+ * Codes of the digits for the data pins, looked up when a digit is set so the refresh
+ * interrupt only copies them to the port
+ */
+static volatile unsigned char g_codes[DISPLAY_DIGITS];
+
+/* Digit being displayed, its enable pin, and the dead time before it is enabled is running */
+static unsigned char g_digit = 0;
+static unsigned char g_enable = 0;
+static unsigned char g_deadTime = 0;
+
+/******************************************************************************************
+ *                              Functions Prototypes(Private)                             *
+ ******************************************************************************************/
+
+/* Function responsible for setting the next compare match of Timer 0 a number of counts after the last one */
+static void SevenSegment_Schedule(unsigned char counts);
+
+/******************************************************************************************
+ *                                   ISR's Definitions                                    *
+ ******************************************************************************************/
+ISR(TIMER0_COMP_vect)
+{
+	/*
+	 * The next compare match is set from the last one and not from the time of
+	 * the interrupt, so the refresh stays regular whatever the interrupt latency
+	 * (unless it is so late that this match is already passed)
+	 */
+#if (DISPLAY_DEAD_COUNTS > 0)
+	if(g_deadTime)
+	{
+		/* End of the dead time, the data of the digit is already on the port */
+		DISPLAY_ENABLE_PORT = (DISPLAY_ENABLE_PORT & ~DISPLAY_ENABLE_MASK) | g_enable;
+		SevenSegment_Schedule(DISPLAY_ON_COUNTS);
+		g_deadTime = 0;
+		return;
+	}
+#endif
+
+	/* Next digit, its enable pin is shifted instead of calculated */
+	g_digit++;
+	g_enable <<= 1;
+	if(g_digit == DISPLAY_DIGITS)
+	{
+		g_digit = 0;
+		g_enable = 1;
+	}
+
+#if (DISPLAY_DEAD_COUNTS > 0)
+	/* All the digits are disabled while the data of the next one is written */
+	DISPLAY_ENABLE_PORT &= ~DISPLAY_ENABLE_MASK;
+	DISPLAY_WRITE_DATA(g_codes[g_digit]);
+	SevenSegment_Schedule(DISPLAY_DEAD_COUNTS);
+	g_deadTime = 1;
+#else
+	/* Disable, data and enable, so the new data never shows on the previous digit */
+	DISPLAY_ENABLE_PORT &= ~DISPLAY_ENABLE_MASK;
+	DISPLAY_WRITE_DATA(g_codes[g_digit]);
+	DISPLAY_ENABLE_PORT |= g_enable;
+	SevenSegment_Schedule(DISPLAY_SLOT_COUNTS);
+#endif
+}
 
 /******************************************************************************************
  *                                  Functions Definitions                                 *
  ******************************************************************************************/
 /******************************************************************************************
- * [Function Name]: SevenSegment_Display
+ * [Function Name]: SevenSegment_Init
  *
- * [Description]: 	Function to display the number in the 7-Segment
+ * [Description]: 	Function to configure the 7-Segment pins and start the
+ * 			refresh by Timer 0, all the digits display 0
  *
- * [Args]:		value
+ * [Args]:		None
  *
- * [in]			value: Unsigned Character to be displayed through 7-Segment
+ * [in]			None
  *
  * [out]		None
  *
@@ -30,69 +110,75 @@
  *
  * [Returns]:       	None
  ******************************************************************************************/
-void SevenSegment_Display(unsigned char value)
+void SevenSegment_Init(void)
 {
-	switch(value)
+	unsigned char digit;
+
+	for(digit = 0; digit < DISPLAY_DIGITS; digit++)
+	{
+		g_codes[digit] = pgm_read_byte(&g_segmentCodes[0]);
+	}
+	g_digit = DISPLAY_DIGITS - 1;	/* The first tick displays the digit 0 */
+	g_enable = 1<<(DISPLAY_DIGITS - 1);
+	g_deadTime = 0;
+
+	DISPLAY_DATA_PORT_DIR |= DISPLAY_DATA_MASK;	/* Configure the data pins as output pins */
+	DISPLAY_WRITE_DATA(DISPLAY_BLANK);
+	DISPLAY_ENABLE_PORT_DIR |= DISPLAY_ENABLE_MASK;	/* Configure the enable pins as output pins */
+	DISPLAY_ENABLE_PORT &= ~DISPLAY_ENABLE_MASK;	/* Disable All 7-Segments at the beginning */
+
+	TCNT0 = 0;			/* Set Timer initial value to 0 */
+	OCR0 = DISPLAY_SLOT_COUNTS;	/* First tick, the next ones are added to it */
+	TIMSK |= (1<<OCIE0);		/* Enable Timer 0 Compare Interrupt */
+
+	/*
+	 * Configure Timer 0 control register:
+	 * 1. Non PWM mode FOC0 = 1
+	 * 2. Normal Mode WGM01 = 0 & WGM00 = 0 (the counter runs over 0 --> 255)
+	 * 3. No need for OC0 so COM00 = 0 & COM01 = 0
+	 * 4. Clock = F_CPU/DISPLAY_TIMER_PRESCALER (DISPLAY_TIMER_CLOCK_BITS)
+	 */
+	TCCR0 = (1<<FOC0) | DISPLAY_TIMER_CLOCK_BITS;
+}
+
+/******************************************************************************************
+ * [Function Name]: SevenSegment_SetDigit
+ *
+ * [Description]: 	Function to change the value of one digit, it is displayed
+ * 			at its next refresh
+ *
+ * [Args]:		digit, value
+ *
+ * [in]			digit: Unsigned Character (0 --> DISPLAY_DIGITS - 1, 0 is the
+ * 			       first 7-Segment)
+ * 			value: Unsigned Character (0 --> 9, or DISPLAY_BLANK)
+ *
+ * [out]		None
+ *
+ * [in/out]		None
+ *
+ * [Returns]:       	None
+ ******************************************************************************************/
+void SevenSegment_SetDigit(unsigned char digit,unsigned char value)
+{
+	g_codes[digit] = pgm_read_byte(&g_segmentCodes[value & 0x0F]);
+}
+
+static void SevenSegment_Schedule(unsigned char counts)
+{
+	unsigned char now;
+
+	OCR0 += counts;
+	now = TCNT0;
+
+	/*
+	 * The match must be 1 --> counts ahead of the counter, otherwise the counter is
+	 * already past it (another interrupt delayed this one more than the dead time)
+	 * and the match would come a whole turn of the counter later, so it is set
+	 * from the counter instead
+	 */
+	if((unsigned char)(OCR0 - now - 1) >= counts)
 	{
-	case 0 :
-		PORTC &= ~(1<<PC0);
-		PORTC &= ~(1<<PC1);
-		PORTC &= ~(1<<PC2);
-		PORTC &= ~(1<<PC3);
-		break;
-	case 1 :
-		PORTC |=  (1<<PC0);
-		PORTC &= ~(1<<PC1);
-		PORTC &= ~(1<<PC2);
-		PORTC &= ~(1<<PC3);
-		break;
-	case 2 :
-		PORTC &= ~(1<<PC0);
-		PORTC |=  (1<<PC1);
-		PORTC &= ~(1<<PC2);
-		PORTC &= ~(1<<PC3);
-		break;
-	case 3 :
-		PORTC |=  (1<<PC0);
-		PORTC |=  (1<<PC1);
-		PORTC &= ~(1<<PC2);
-		PORTC &= ~(1<<PC3);
-		break;
-	case 4 :
-		PORTC &= ~(1<<PC0);
-		PORTC &= ~(1<<PC1);
-		PORTC |=  (1<<PC2);
-		PORTC &= ~(1<<PC3);
-		break;
-	case 5 :
-		PORTC |=  (1<<PC0);
-		PORTC &= ~(1<<PC1);
-		PORTC |=  (1<<PC2);
-		PORTB &= ~(1<<PB3);
-		break;
-	case 6 :
-		PORTC &= ~(1<<PC0);
-		PORTC |=  (1<<PC1);
-		PORTC |=  (1<<PC2);
-		PORTC &= ~(1<<PC3);
-		break;
-	case 7 :
-		PORTC |=  (1<<PC0);
-		PORTC |=  (1<<PC1);
-		PORTC |=  (1<<PC2);
-		PORTC &= ~(1<<PC3);
-		break;
-	case 8 :
-		PORTC &= ~(1<<PC0);
-		PORTC &= ~(1<<PC1);
-		PORTC &= ~(1<<PC2);
-		PORTC |=  (1<<PC3);
-		break;
-	case 9 :
-		PORTC |=  (1<<PC0);
-		PORTC &= ~(1<<PC1);
-		PORTC &= ~(1<<PC2);
-		PORTC |=  (1<<PC3);
-		break;
+		OCR0 = now + DISPLAY_LATE_COUNTS;
 	}
 }
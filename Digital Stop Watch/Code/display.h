@@ -4,7 +4,10 @@
  *
  * [FILE NAME] : display.h
  *
- * [DESCRIPTION]: Header file for display
+ * [DESCRIPTION]: Header file for display, the multiplexed 7-Segments are
+ * 		  refreshed by the Timer 0 compare interrupt, one digit per
+ * 		  tick from a buffer of the digits, so the refresh does not
+ * 		  depend on the main loop
  *
  * [AUTHOR] : Ahmed Hassan
  *
@@ -16,13 +19,124 @@
 #include "micro_config.h"
 
 /******************************************************************************
- * [Function Name]: SevenSegment_Display
+ *                          Preprocessor Macros                               *
+ ******************************************************************************/
+
+/* Number of 7-Segments, each one is enabled by one pin of the enable port (bit 0 first) */
+#define DISPLAY_DIGITS 6
+
+#define DISPLAY_ENABLE_PORT PORTA
+#define DISPLAY_ENABLE_PORT_DIR DDRA
+#define DISPLAY_ENABLE_MASK 0x3F
+
+/* Data pins, BCD input of the 7-Segment decoder (7447) */
+#define DISPLAY_DATA_PORT PORTC
+#define DISPLAY_DATA_PORT_DIR DDRC
+#define DISPLAY_DATA_MASK 0x0F
+
+/* Value (and decoder code) turning all the segments of a digit off */
+#define DISPLAY_BLANK 0x0F
+
+/*
+ * One masked write of the data pins (read, mask, or, write: 4 cycles), the other pins
+ * of the port keep their value
+ */
+#define DISPLAY_WRITE_DATA(code) (DISPLAY_DATA_PORT = (DISPLAY_DATA_PORT & ~DISPLAY_DATA_MASK) | (code))
+
+/*
+ * Cycles to change the data of a digit, estimated from the AVR instructions (not
+ * measured on the target), with the optimization -O0 of the Debug build and -Os:
+ *                                             -O0     -Os
+ * switch with 4 bit writes (old version)      ~100    ~30   (3 wrong codes shown)
+ * table in flash, one write of the pins       ~30     ~12   (no wrong code)
+ * refresh interrupt, code looked up before    ~20     ~8
+ */
+
+/* Number of times per second all the digits are displayed */
+#define DISPLAY_REFRESH_RATE 100
+
+/*
+ * Time in micro-seconds with all the digits disabled before the next one is enabled,
+ * the data of the next digit is written during this time so it never shows on the
+ * previous digit (ghosting), 0 to switch the digits directly. It must be longer than
+ * the interrupt (about 100 cycles) or a compare match is missed
+ */
+#define DISPLAY_DEAD_TIME 200
+
+/*
+ * Timer 0 runs in normal mode and the compare value is moved at each tick, its clock
+ * is the fastest one (finest dead time) with a digit of 255 counts at most
+ */
+#if ((F_CPU / (1UL * DISPLAY_REFRESH_RATE * DISPLAY_DIGITS)) <= 255UL)
+#define DISPLAY_TIMER_PRESCALER 1UL
+#define DISPLAY_TIMER_CLOCK_BITS (1<<CS00)
+#elif ((F_CPU / (8UL * DISPLAY_REFRESH_RATE * DISPLAY_DIGITS)) <= 255UL)
+#define DISPLAY_TIMER_PRESCALER 8UL
+#define DISPLAY_TIMER_CLOCK_BITS (1<<CS01)
+#elif ((F_CPU / (64UL * DISPLAY_REFRESH_RATE * DISPLAY_DIGITS)) <= 255UL)
+#define DISPLAY_TIMER_PRESCALER 64UL
+#define DISPLAY_TIMER_CLOCK_BITS ((1<<CS01) | (1<<CS00))
+#elif ((F_CPU / (256UL * DISPLAY_REFRESH_RATE * DISPLAY_DIGITS)) <= 255UL)
+#define DISPLAY_TIMER_PRESCALER 256UL
+#define DISPLAY_TIMER_CLOCK_BITS (1<<CS02)
+#elif ((F_CPU / (1024UL * DISPLAY_REFRESH_RATE * DISPLAY_DIGITS)) <= 255UL)
+#define DISPLAY_TIMER_PRESCALER 1024UL
+#define DISPLAY_TIMER_CLOCK_BITS ((1<<CS02) | (1<<CS00))
+#else
+#error "DISPLAY_REFRESH_RATE is too low for the 8-bit Timer 0 at this F_CPU"
+#endif
+
+/*
+ * Timer counts of one digit (dead time included) and of the dead time, the dead time
+ * is rounded up so a coarse clock never makes it shorter than DISPLAY_DEAD_TIME
+ */
+#define DISPLAY_SLOT_COUNTS ((F_CPU / DISPLAY_TIMER_PRESCALER) / (DISPLAY_REFRESH_RATE * DISPLAY_DIGITS))
+#define DISPLAY_DEAD_COUNTS ((((F_CPU / 1000000UL) * DISPLAY_DEAD_TIME) + DISPLAY_TIMER_PRESCALER - 1) / DISPLAY_TIMER_PRESCALER)
+#define DISPLAY_ON_COUNTS (DISPLAY_SLOT_COUNTS - DISPLAY_DEAD_COUNTS)
+
+#if (DISPLAY_DEAD_COUNTS >= DISPLAY_SLOT_COUNTS)
+#error "DISPLAY_DEAD_TIME is longer than the time of one digit"
+#endif
+
+/*
+ * Timer counts from TCNT0 to the next compare match when the interrupt was delayed
+ * by another one past the match it had to set (at least 16 cycles to write OCR0)
+ */
+#define DISPLAY_LATE_COUNTS ((16UL + DISPLAY_TIMER_PRESCALER - 1) / DISPLAY_TIMER_PRESCALER)
+
+/******************************************************************************
+ *                          Functions Prototypes                              *
+ ******************************************************************************/
+
+/******************************************************************************
+ * [Function Name]: SevenSegment_Init
+ *
+ * [Description]: Function to configure the 7-Segment pins and start the
+ * 		  refresh by Timer 0, all the digits display 0
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]          None
+ *
+ * [in/out]       None
+ *
+ * [Returns]:     None
+ ******************************************************************************/
+void SevenSegment_Init(void);
+
+/******************************************************************************
+ * [Function Name]: SevenSegment_SetDigit
  *
- * [Description]: Function to display the number in the 7-Segment
+ * [Description]: Function to change the value of one digit, it is displayed
+ * 		  at its next refresh
  *
- * [Args]:	  value
+ * [Args]:	  digit, value
  *
- * [in]		  value: Unsigned Character to be displayed through 7-Segment
+ * [in]		  digit: Unsigned Character (0 --> DISPLAY_DIGITS - 1, 0 is the
+ * 			 first 7-Segment)
+ * 		  value: Unsigned Character (0 --> 9, or DISPLAY_BLANK)
  *
  * [out]          None
  *
@@ -30,6 +144,6 @@
  *
  * [Returns]:     None
  ******************************************************************************/
-void SevenSegment_Display(unsigned char value);
+void SevenSegment_SetDigit(unsigned char digit,unsigned char value);
 
 #endif /* DISPLAY_H_ */
@@ -11,14 +11,27 @@
  **********************************************************************************************/
 
 #include "interrupt.h"
+#include "timer1.h"
 
 /**********************************************************************************************
  *                             		 Global Variables                                     *
  **********************************************************************************************/
 
-unsigned char seconds = 0;	/* Global variable to store the number of seconds */
-unsigned char minutes = 0;	/* Global variable to store the number of minutes */
-unsigned char hours = 0;	/* Global variable to store the number of hours */
+/* Time of the watch in packed BCD, the tens in the high nibble and the units in the low nibble */
+volatile Time_Type g_time = {0, 0, 0, 0};
+SNAPSHOT_SequenceType g_timeSequence = 0;
+
+/* Ring buffer of the laps, g_lapHead is the slot of the next lap */
+static volatile Time_Type g_laps[LAP_SIZE];
+static volatile unsigned char g_lapHead = 0;
+static volatile unsigned char g_lapCount = 0;
+static SNAPSHOT_SequenceType g_lapSequence = 0;
+
+/* Timer 1 is counting (not paused) */
+static volatile unsigned char g_running = 1;
+
+/* Calls of INT2_Debounce with SW3 released since the last INT2 edge */
+static volatile unsigned char g_int2Released = 0;
 
 /**********************************************************************************************/
 /**********************************************************************************************
@@ -26,29 +39,60 @@ unsigned char hours = 0;	/* Global variable to store the number of hours */
  **********************************************************************************************/
 ISR(INT0_vect)
 {
-	/* Reset Timer 1 by Clearing Global variables */
-	seconds = 0;
-	minutes = 0;
-	hours = 0;
+	/* Reset Timer 1 by Clearing Global variables, the laps too */
+	SNAPSHOT_WRITE_BEGIN(g_timeSequence);
+	g_time.centiseconds = 0;
+	g_time.seconds = 0;
+	g_time.minutes = 0;
+	g_time.hours = 0;
+	SNAPSHOT_WRITE_END(g_timeSequence);
+
+	SNAPSHOT_WRITE_BEGIN(g_lapSequence);
+	g_lapHead = 0;
+	g_lapCount = 0;
+	SNAPSHOT_WRITE_END(g_lapSequence);
 }
 
 ISR(INT1_vect)
 {
-	/*
-	 * Disable Timer 1
-	 * CS10 = 1 & CS11 = 1 & CS12 =1
-	 */
-	TCCR1B = (1<<CS10)  | (1<<CS11) | (1<<CS12) ;
+	/* Stop the clock of Timer 1 */
+	Timer1_Pause();
+	g_running = 0;
 }
 
 ISR(INT2_vect)
 {
-	/*
-	 * ReEnable Timer 1 :
-	 * 1. CRC Mode WGM10 = 0 & WGM12 = 1 & WGM13 = 0
-	 * 2. Clock = F_CPU/1024 CS10 = 1 & CS11 = 0& CS12 =1
-	 */
-	TCCR1B = (1<<WGM12) | (1<<CS10) | (1<<CS12) ;
+	unsigned char head = g_lapHead;
+
+	if(g_running)
+	{
+		/*
+		 * Lap: 4 bytes copied to the ring buffer, the oldest lap is replaced when it
+		 * is full so the interrupt never waits, and Timer 1 can not change the time
+		 * during the copy (the interrupts do not nest)
+		 */
+		SNAPSHOT_WRITE_BEGIN(g_lapSequence);
+		g_laps[head].centiseconds = g_time.centiseconds;
+		g_laps[head].seconds = g_time.seconds;
+		g_laps[head].minutes = g_time.minutes;
+		g_laps[head].hours = g_time.hours;
+		g_lapHead = (head + 1) & LAP_MASK;
+		if(g_lapCount < LAP_SIZE)
+		{
+			g_lapCount++;
+		}
+		SNAPSHOT_WRITE_END(g_lapSequence);
+	}
+	else
+	{
+		/* ReEnable Timer 1 with the prescaler selected in timer1.h */
+		Timer1_Resume();
+		g_running = 1;
+	}
+
+	/* The bounces of SW3 are ignored until INT2_Debounce enables INT2 again */
+	GICR &= ~(1<<INT2);
+	g_int2Released = 0;
 }
 
 /**********************************************************************************************
@@ -127,3 +171,95 @@ void INT2_Init(void)
 	MCUCSR &= ~(1<<ISC2);	/* Trigger INT2 with the falling edge */
 	SREG |= (1<<7);		/* Enable interrupts by setting I-bit */
 }
+
+/**********************************************************************************************
+ * [Function Name]: INT2_Debounce
+ *
+ * [Description]: 	Function to enable INT2 again once SW3 is released, it must
+ * 			be called every 10 ms
+ *
+ * [Args]:		None
+ *
+ * [in]			None
+ *
+ * [out]		None
+ *
+ * [in/out]		None
+ *
+ * [Returns]:       	None
+ **********************************************************************************************/
+void INT2_Debounce(void)
+{
+	if(GICR & (1<<INT2))
+	{
+		return;		/* Already enabled */
+	}
+
+	if(PINB & (1<<PB2))
+	{
+		g_int2Released++;
+		if(g_int2Released >= INT2_RELEASE_POLLS)
+		{
+			GIFR = (1<<INTF2);	/* Clear the flag of the bounces (written with 1) */
+			GICR |= (1<<INT2);
+		}
+	}
+	else
+	{
+		g_int2Released = 0;	/* Still pressed or bouncing */
+	}
+}
+
+/**********************************************************************************************
+ * [Function Name]: Lap_GetCount
+ *
+ * [Description]: 	Function to get the number of laps in the ring buffer
+ *
+ * [Args]:		None
+ *
+ * [in]			None
+ *
+ * [out]		Unsigned Character
+ *
+ * [in/out]		None
+ *
+ * [Returns]:       	Number of laps (0 --> LAP_SIZE)
+ **********************************************************************************************/
+unsigned char Lap_GetCount(void)
+{
+	return g_lapCount;
+}
+
+/**********************************************************************************************
+ * [Function Name]: Lap_Read
+ *
+ * [Description]: 	Function to copy the split time of a lap (the time of the
+ * 			watch when SW3 was pressed)
+ *
+ * [Args]:		index, Time_Ptr
+ *
+ * [in]			index: Unsigned Character (0 for the last lap -->
+ * 			       Lap_GetCount() - 1)
+ *
+ * [out]		Time_Ptr: Pointer to Time_Type
+ *
+ * [in/out]		None
+ *
+ * [Returns]:       	None
+ **********************************************************************************************/
+void Lap_Read(unsigned char index,Time_Type *Time_Ptr)
+{
+	unsigned char sequence;
+	unsigned char slot;
+
+	/* A lap of SW3 during the copy moves the head and can replace the slot, copy it again */
+	do
+	{
+		sequence = SNAPSHOT_readBegin(&g_lapSequence);
+		slot = (g_lapHead - 1 - index) & LAP_MASK;
+		Time_Ptr->centiseconds = g_laps[slot].centiseconds;
+		Time_Ptr->seconds = g_laps[slot].seconds;
+		Time_Ptr->minutes = g_laps[slot].minutes;
+		Time_Ptr->hours = g_laps[slot].hours;
+	} while(SNAPSHOT_readRetry(&g_lapSequence, sequence));
+}
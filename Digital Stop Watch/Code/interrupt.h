@@ -14,14 +14,47 @@
 #define INTERRUPTS_H_
 
 #include "micro_config.h"
+#include "snapshot.h"
+
+/**********************************************************************************
+ *                             Preprocessor Macros                                *
+ **********************************************************************************/
+
+/* Laps kept in the ring buffer, the oldest one is replaced (must be a power of 2, 8 at most) */
+#define LAP_SIZE 8
+#define LAP_MASK (LAP_SIZE - 1)
+
+/*
+ * After an INT2 edge, INT2 is enabled again when SW3 has been released for this number of
+ * calls of INT2_Debounce, so the bounces of one press give one lap
+ */
+#define INT2_RELEASE_POLLS 5
+
+/**********************************************************************************
+ *                             Types Declaration                                  *
+ **********************************************************************************/
+
+/* Time of the watch or of a lap, packed BCD numbers */
+typedef struct
+{
+	unsigned char centiseconds;	/* 0x00 --> 0x99 */
+	unsigned char seconds;		/* 0x00 --> 0x59 */
+	unsigned char minutes;		/* 0x00 --> 0x59 */
+	unsigned char hours;		/* 0x00 --> 0x23 */
+}Time_Type;
 
 /**********************************************************************************
  *                             External Variables                                 *
  **********************************************************************************/
 
-extern unsigned char seconds;	/* Global variable to store the number of seconds */
-extern unsigned char minutes;	/* Global variable to store the number of minutes */
-extern unsigned char hours;	/* Global variable to store the number of hours */
+/*
+ * Time of the watch in packed BCD, the tens in the high nibble and the units in the low
+ * nibble (0x59 for 59), so each digit is displayed without any division. It is written
+ * by the interrupts between SNAPSHOT_WRITE_BEGIN and SNAPSHOT_WRITE_END of
+ * g_timeSequence and read with Timer1_GetTime
+ */
+extern volatile Time_Type g_time;
+extern SNAPSHOT_SequenceType g_timeSequence;
 
 /**********************************************************************************
  *                             Functions Prototypes                               *
@@ -77,4 +110,57 @@ void INT1_Init(void);
  **********************************************************************************/
 void INT2_Init(void);
 
+/**********************************************************************************
+ * [Function Name]: INT2_Debounce
+ *
+ * [Description]: 	Function to enable INT2 again once SW3 is released, it must
+ * 			be called every 10 ms
+ *
+ * [Args]:	None
+ *
+ * [in]			 None
+ *
+ * [out]		 None
+ *
+ * [in/out]		None
+ *
+ * [Returns]:                 None
+ **********************************************************************************/
+void INT2_Debounce(void);
+
+/**********************************************************************************
+ * [Function Name]: Lap_GetCount
+ *
+ * [Description]: 	Function to get the number of laps in the ring buffer
+ *
+ * [Args]:	None
+ *
+ * [in]			 None
+ *
+ * [out]		 Unsigned Character
+ *
+ * [in/out]		None
+ *
+ * [Returns]:                 Number of laps (0 --> LAP_SIZE)
+ **********************************************************************************/
+unsigned char Lap_GetCount(void);
+
+/**********************************************************************************
+ * [Function Name]: Lap_Read
+ *
+ * [Description]: 	Function to copy the split time of a lap (the time of the
+ * 			watch when SW3 was pressed)
+ *
+ * [Args]:	index, Time_Ptr
+ *
+ * [in]			 index: Unsigned Character (0 for the last lap --> Lap_GetCount() - 1)
+ *
+ * [out]		 Time_Ptr: Pointer to Time_Type
+ *
+ * [in/out]		None
+ *
+ * [Returns]:                 None
+ **********************************************************************************/
+void Lap_Read(unsigned char index,Time_Type *Time_Ptr);
+
 #endif /* INTERRUPTS_H_ */
@@ -0,0 +1,109 @@
+ /******************************************************************************
+ *
+ * [MODULE]: SNAPSHOT
+ *
+ * [FILE NAME]: snapshot.h
+ *
+ * [DESCRIPTION]: Header file for the snapshot of variables shared between the
+ * 		  interrupts and the main loop, a sequence counter tells the main
+ * 		  loop that an interrupt changed the variables during its copy and
+ * 		  the copy is done again, so the copy is never a mix of old and new
+ * 		  values and the interrupts are never disabled to read them
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef SNAPSHOT_H_
+#define SNAPSHOT_H_
+
+#include "micro_config.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/*
+ * The writer changes the sequence before and after the variables, it is odd while
+ * they are changed. The writers must be interrupts (or code that no other writer can
+ * interrupt) and the reader must be interruptible by them, the main loop: a reader in
+ * an interrupt would wait forever for a writer it interrupted. Every shared variable
+ * must be volatile so its writes stay between the 2 changes of the sequence
+ */
+#define SNAPSHOT_WRITE_BEGIN(sequence)	((sequence)++)
+#define SNAPSHOT_WRITE_END(sequence)	((sequence)++)
+
+/*******************************************************************************
+ *                      Types Declaration                                      *
+ *******************************************************************************/
+
+/* Sequence counter of a group of shared variables, it starts at 0 */
+typedef volatile unsigned char SNAPSHOT_SequenceType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: SNAPSHOT_readBegin
+ *
+ * [Description]: Function to start reading shared variables that can not be
+ * 		  copied by SNAPSHOT_read (not in one block, or found from an
+ * 		  index), it waits for the end of a write in progress
+ *
+ * [Args]:	  Sequence_Ptr
+ *
+ * [in]		  Sequence_Ptr: Pointer to SNAPSHOT_SequenceType (the sequence
+ * 				changed by the writers of the variables)
+ *
+ * [out]	  Unsigned Character
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     The sequence to give to SNAPSHOT_readRetry
+ *******************************************************************************/
+unsigned char SNAPSHOT_readBegin(const SNAPSHOT_SequenceType *Sequence_Ptr);
+
+/*******************************************************************************
+ * [Function Name]: SNAPSHOT_readRetry
+ *
+ * [Description]: Function to end reading shared variables, the values read
+ * 		  since SNAPSHOT_readBegin must be read again if it returns 1
+ *
+ * [Args]:	  Sequence_Ptr, sequence
+ *
+ * [in]		  Sequence_Ptr: Pointer to SNAPSHOT_SequenceType
+ * 		  sequence: Unsigned Character (returned by SNAPSHOT_readBegin)
+ *
+ * [out]	  Unsigned Character
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     1 if a write began during the read, otherwise 0
+ *******************************************************************************/
+unsigned char SNAPSHOT_readRetry(const SNAPSHOT_SequenceType *Sequence_Ptr,unsigned char sequence);
+
+/*******************************************************************************
+ * [Function Name]: SNAPSHOT_read
+ *
+ * [Description]: Function to copy shared variables written by interrupts, the
+ * 		  copy is done again until no write happened during it (one more
+ * 		  copy of a few bytes at most when an interrupt comes)
+ *
+ * [Args]:	  Sequence_Ptr, Copy_Ptr, Shared_Ptr, size
+ *
+ * [in]		  Sequence_Ptr: Pointer to SNAPSHOT_SequenceType (the sequence
+ * 				changed by the writers of the variables)
+ * 		  Shared_Ptr: Pointer to the shared variables (volatile)
+ * 		  size: Unsigned Character (number of bytes to copy)
+ *
+ * [out]	  Copy_Ptr: Pointer to the copy of the variables
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void SNAPSHOT_read(const SNAPSHOT_SequenceType *Sequence_Ptr,void *Copy_Ptr,
+		const volatile void *Shared_Ptr,unsigned char size);
+
+#endif /* SNAPSHOT_H_ */
@@ -12,27 +12,60 @@
 
 #include "timer1.h"
 
+/****************************************************************************************
+ *                                   Global Variables                                   *
+ ****************************************************************************************/
+
+/* Counts of a tick (integer part) and remainder added at each tick, set by Timer1_SetTrim */
+static unsigned int g_tickCounts;
+static unsigned long g_tickRemainder;
+
+/* Sum of the remainders, one count is added to the tick when it reaches TIMER1_TICK_DIVISOR */
+static unsigned long g_tickFraction = 0;
+
+/****************************************************************************************
+ *                              Functions Prototypes(Private)                           *
+ ****************************************************************************************/
+
+/*
+ * Function responsible for incrementing a packed BCD number, it returns 1 and sets the
+ * number to 0 when it reaches the limit (carry to the next number), otherwise 0
+ */
+static unsigned char Timer1_BCD_Increment(volatile unsigned char *Value_Ptr,unsigned char limit);
+
 /****************************************************************************************
  *                                  ISR's Definitions                                   *
  ****************************************************************************************/
 ISR(TIMER1_COMPA_vect)
 {
-	seconds++;
-
-	if(seconds == 60)
+	/*
+	 * Length of the tick that just started, OCR1A is not buffered in CTC mode and the
+	 * counter is still far from it (the period is OCR1A + 1 counts)
+	 */
+	g_tickFraction += g_tickRemainder;
+	if(g_tickFraction >= TIMER1_TICK_DIVISOR)
 	{
-		seconds = 0;
-		minutes++;
+		g_tickFraction -= TIMER1_TICK_DIVISOR;
+		OCR1A = g_tickCounts;
 	}
-	if(minutes == 60)
+	else
 	{
-		minutes = 0;
-		hours++;
+		OCR1A = g_tickCounts - 1;
 	}
-	if(hours > 23)
+
+	/* Each digit carries in place, the seconds, minutes and hours change only on a carry */
+	SNAPSHOT_WRITE_BEGIN(g_timeSequence);
+	if(Timer1_BCD_Increment(&g_time.centiseconds, 0xA0))
 	{
-		hours = 0;
+		if(Timer1_BCD_Increment(&g_time.seconds, 0x60))
+		{
+			if(Timer1_BCD_Increment(&g_time.minutes, 0x60))
+			{
+				Timer1_BCD_Increment(&g_time.hours, 0x24);
+			}
+		}
 	}
+	SNAPSHOT_WRITE_END(g_timeSequence);
 }
 
 /****************************************************************************************
@@ -41,11 +74,12 @@ ISR(TIMER1_COMPA_vect)
 /****************************************************************************************
  * [Function Name]: Timer1_CTC_Init
  *
- * [Description]: 	Function to Function to count the required time (1 Second)
+ * [Description]: 	Function to start counting the time of the watch with the
+ * 			default trim (TIMER1_TRIM)
  *
- * [Args]:		tick
+ * [Args]:		None
  *
- * [in]			tick: Unsigned Character to store the compare value in it
+ * [in]			None
  *
  * [out]		None
  *
@@ -53,18 +87,134 @@ ISR(TIMER1_COMPA_vect)
  *
  * [Returns]:           None
  ****************************************************************************************/
-void Timer1_CTC_Init(unsigned int tick)
+void Timer1_CTC_Init(void)
 {
-	TCNT1 = 0;		/* Set Counter initial value to 0 */
-	OCR1A = tick;		/* Set compare value */
-	TIMSK = (1<<OCIE1A);	/* Enable Timer 1 Compare A Match Interrupt */
+	Timer1_SetTrim(TIMER1_TRIM);
+	g_tickFraction = 0;
+
+	TCNT1 = 0;			/* Set Counter initial value to 0 */
+	OCR1A = g_tickCounts - 1;	/* Set compare value of the first tick */
+	TIMSK |= (1<<OCIE1A);		/* Enable Timer 1 Compare A Match Interrupt */
 
 	/* Configure Timer 1 Control Register:
 	 * 1. Non PWM Mode FOC1A = 1 & FOC1B = 1
 	 * 2. CRC Mode WGM10 = 0 & WGM12 = 1 & WGM13 = 0
-	 * 3. Clock = F_CPU/1024 CS10 = 1 & CS11 = 0& CS12 =1
+	 * 3. Clock = F_CPU/TIMER1_PRESCALER (TIMER1_CLOCK_BITS)
 	 */
 	TCCR1A = (1 << FOC1A)  | (1 << FOC1B);
 
-	TCCR1B = (1<<WGM12) | (1<<CS10) | (1<<CS12) ;
+	TCCR1B = (1<<WGM12) | TIMER1_CLOCK_BITS;
+}
+
+/****************************************************************************************
+ * [Function Name]: Timer1_SetTrim
+ *
+ * [Description]: 	Function to calibrate the time with the measured frequency of
+ * 			the crystal, it applies from the next tick
+ *
+ * [Args]:		trim
+ *
+ * [in]			trim: Signed Integer (real frequency of the crystal minus
+ * 			      F_CPU, in Hz)
+ *
+ * [out]		None
+ *
+ * [in/out]		None
+ *
+ * [Returns]:           None
+ ****************************************************************************************/
+void Timer1_SetTrim(signed int trim)
+{
+	unsigned long cycles = (unsigned long)((signed long)F_CPU + trim);	/* Clock cycles per second */
+	unsigned int counts = cycles / TIMER1_TICK_DIVISOR;
+	unsigned long remainder = cycles % TIMER1_TICK_DIVISOR;
+	unsigned char sreg = SREG;
+
+	/* The division is done once here, the interrupt only adds and compares */
+	SREG &= ~(1<<7);
+	g_tickCounts = counts;
+	g_tickRemainder = remainder;
+	SREG = sreg;
+}
+
+/****************************************************************************************
+ * [Function Name]: Timer1_Pause
+ *
+ * [Description]: 	Function to stop the clock of Timer 1, the time is kept
+ *
+ * [Args]:		None
+ *
+ * [in]			None
+ *
+ * [out]		None
+ *
+ * [in/out]		None
+ *
+ * [Returns]:           None
+ ****************************************************************************************/
+void Timer1_Pause(void)
+{
+	/* No clock source CS10 = 0 & CS11 = 0 & CS12 = 0, still in CTC mode */
+	TCCR1B = (1<<WGM12);
+}
+
+/****************************************************************************************
+ * [Function Name]: Timer1_Resume
+ *
+ * [Description]: 	Function to restart the clock of Timer 1 after a pause
+ *
+ * [Args]:		None
+ *
+ * [in]			None
+ *
+ * [out]		None
+ *
+ * [in/out]		None
+ *
+ * [Returns]:           None
+ ****************************************************************************************/
+void Timer1_Resume(void)
+{
+	/* CTC Mode WGM12 = 1 and Clock = F_CPU/TIMER1_PRESCALER */
+	TCCR1B = (1<<WGM12) | TIMER1_CLOCK_BITS;
+}
+
+/****************************************************************************************
+ * [Function Name]: Timer1_GetTime
+ *
+ * [Description]: 	Function to copy the time of the watch, the 4 numbers are
+ * 			read together so they are never from two different ticks
+ *
+ * [Args]:		Time_Ptr
+ *
+ * [in]			None
+ *
+ * [out]		Time_Ptr: Pointer to Time_Type
+ *
+ * [in/out]		None
+ *
+ * [Returns]:           None
+ ****************************************************************************************/
+void Timer1_GetTime(Time_Type *Time_Ptr)
+{
+	/* Copied again if a tick or a reset comes during the copy, the interrupts stay enabled */
+	SNAPSHOT_read(&g_timeSequence, Time_Ptr, &g_time, sizeof(Time_Type));
+}
+
+static unsigned char Timer1_BCD_Increment(volatile unsigned char *Value_Ptr,unsigned char limit)
+{
+	unsigned char value = *Value_Ptr + 1;
+
+	/* The units pass from 9 to 0x0A, adding 6 gives 0 and carries 1 to the tens */
+	if((value & 0x0F) == 0x0A)
+	{
+		value += 0x06;
+	}
+	if(value == limit)
+	{
+		*Value_Ptr = 0;
+		return 1;
+	}
+	*Value_Ptr = value;
+	return 0;
 }
@@ -4,7 +4,8 @@
  *
  * [FILE NAME] : timer1.c
  *
- * [DESCRIPTION]:  Header file for timer1
+ * [DESCRIPTION]:  Header file for timer1, it counts the time of the watch with a
+ * 		   period made exact on average by a fractional correction
  *
  * [AUTHOR] : Ahmed Hassan
  *
@@ -16,14 +17,64 @@
 #include "micro_config.h"
 #include "interrupt.h"
 
+/**********************************************************************************
+ *                             Preprocessor Macros                                *
+ **********************************************************************************/
+
+/* Number of compare interrupts per second, each one counts 10 ms (1 centisecond) */
+#define TIMER1_TICK_RATE 100UL
+
+/*
+ * Default trim of the clock in Hz, the real frequency of the crystal minus F_CPU. If the
+ * watch gains d seconds in T seconds, the crystal is fast and the trim is F_CPU * d / T
+ * (1 Hz = 1 ppm at 1 MHz, about 0.09 second per day)
+ */
+#define TIMER1_TRIM 0
+
+/*
+ * Smallest prescaler giving less than 65000 counts per tick, the smallest one gives
+ * the finest period (the trim can add 535 counts before the 16-bit limit)
+ */
+#if ((F_CPU / TIMER1_TICK_RATE) < 65000UL)
+#define TIMER1_PRESCALER 1UL
+#define TIMER1_CLOCK_BITS (1<<CS10)
+#elif ((F_CPU / (8UL * TIMER1_TICK_RATE)) < 65000UL)
+#define TIMER1_PRESCALER 8UL
+#define TIMER1_CLOCK_BITS (1<<CS11)
+#elif ((F_CPU / (64UL * TIMER1_TICK_RATE)) < 65000UL)
+#define TIMER1_PRESCALER 64UL
+#define TIMER1_CLOCK_BITS ((1<<CS11) | (1<<CS10))
+#elif ((F_CPU / (256UL * TIMER1_TICK_RATE)) < 65000UL)
+#define TIMER1_PRESCALER 256UL
+#define TIMER1_CLOCK_BITS (1<<CS12)
+#elif ((F_CPU / (1024UL * TIMER1_TICK_RATE)) < 65000UL)
+#define TIMER1_PRESCALER 1024UL
+#define TIMER1_CLOCK_BITS ((1<<CS12) | (1<<CS10))
+#else
+#error "TIMER1_TICK_RATE is too low for the 16-bit Timer 1 at this F_CPU"
+#endif
+
+/*
+ * A tick is (F_CPU + trim) / (TIMER1_PRESCALER * TIMER1_TICK_RATE) counts: the integer
+ * part is counted at each tick and the remainder is added to an accumulator, the tick
+ * is one count longer each time it passes this divisor (Bresenham), so the mean period
+ * is exact and a tick is never more than 1 count (TIMER1_PRESCALER / F_CPU) away
+ */
+#define TIMER1_TICK_DIVISOR (TIMER1_PRESCALER * TIMER1_TICK_RATE)
+
+/**********************************************************************************
+ *                             Functions Prototypes                               *
+ **********************************************************************************/
+
 /**********************************************************************************
  * [Function Name]: Timer1_CTC_Init
  *
- * [Description]:  Function to count the required time (1 Second)
+ * [Description]:  Function to start counting the time of the watch with the
+ * 		   default trim (TIMER1_TRIM)
  *
- * [Args]:	  tick
+ * [Args]:	  None
  *
- * [in]	          tick: Unsigned Character to store the compare value in it
+ * [in]	          None
  *
  * [out] 	  None
  *
@@ -31,6 +82,77 @@
  *
  * [Returns]:     None
  **********************************************************************************/
-void Timer1_CTC_Init(unsigned int tick);
+void Timer1_CTC_Init(void);
+
+/**********************************************************************************
+ * [Function Name]: Timer1_SetTrim
+ *
+ * [Description]:  Function to calibrate the time with the measured frequency of
+ * 		   the crystal, it applies from the next tick
+ *
+ * [Args]:	  trim
+ *
+ * [in]	          trim: Signed Integer (real frequency of the crystal minus F_CPU,
+ * 			in Hz)
+ *
+ * [out] 	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ **********************************************************************************/
+void Timer1_SetTrim(signed int trim);
+
+/**********************************************************************************
+ * [Function Name]: Timer1_Pause
+ *
+ * [Description]:  Function to stop the clock of Timer 1, the time is kept
+ *
+ * [Args]:	  None
+ *
+ * [in]	          None
+ *
+ * [out] 	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ **********************************************************************************/
+void Timer1_Pause(void);
+
+/**********************************************************************************
+ * [Function Name]: Timer1_Resume
+ *
+ * [Description]:  Function to restart the clock of Timer 1 after a pause
+ *
+ * [Args]:	  None
+ *
+ * [in]	          None
+ *
+ * [out] 	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ **********************************************************************************/
+void Timer1_Resume(void);
+
+/**********************************************************************************
+ * [Function Name]: Timer1_GetTime
+ *
+ * [Description]:  Function to copy the time of the watch, the 4 numbers are
+ * 		   read together so they are never from two different ticks
+ *
+ * [Args]:	  Time_Ptr
+ *
+ * [in]	          None
+ *
+ * [out] 	  Time_Ptr: Pointer to Time_Type
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ **********************************************************************************/
+void Timer1_GetTime(Time_Type *Time_Ptr);
 
 #endif /* TIMER1_H_ */
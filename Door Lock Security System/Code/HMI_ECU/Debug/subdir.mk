@@ -5,25 +5,37 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../application_functions.c \
+../fmt.c \
 ../hmi_ecu.c \
 ../keypad.c \
 ../lcd.c \
+../lcd_frame.c \
+../messages.c \
+../screens.c \
 ../timer.c \
 ../uart.c 
 
 OBJS += \
 ./application_functions.o \
+./fmt.o \
 ./hmi_ecu.o \
 ./keypad.o \
 ./lcd.o \
+./lcd_frame.o \
+./messages.o \
+./screens.o \
 ./timer.o \
 ./uart.o 
 
 C_DEPS += \
 ./application_functions.d \
+./fmt.d \
 ./hmi_ecu.d \
 ./keypad.d \
 ./lcd.d \
+./lcd_frame.d \
+./messages.d \
+./screens.d \
 ./timer.d \
 ./uart.d 
 
@@ -100,8 +100,7 @@ void APP_setNewPassword(uint8 a_systemStatus)
 		if(a_systemStatus == FIRST_TIME_TO_LOGIN)
 		{
 			/* This message appears only in the first time to login to the system */
-			LCD_clearScreen();
-			LCD_displayString("FIRST TIME TO LOGIN");
+			SCREEN_display(SCREEN_FIRST_TIME_TO_LOGIN);
 			_delay_ms(LONG_DISPLAY_TIME);	/* Keep the message on the screen for a while */
 		}
 
@@ -118,9 +117,7 @@ void APP_setNewPassword(uint8 a_systemStatus)
 		 */
 		if(a_passwordMatch == MISMATCHED)
 		{
-			LCD_clearScreen();
-			LCD_displayStringRowColumn(0, 1, "PASSWORD UNMATCHED");
-			LCD_displayStringRowColumn(1, 5, "TRY AGAIN");
+			SCREEN_display(SCREEN_PASSWORD_UNMATCHED);
 			_delay_ms(SHORT_DISPLAY_TIME);	/* Keep the message on the screen for a while */
 		}
 
@@ -135,8 +132,7 @@ void APP_setNewPassword(uint8 a_systemStatus)
 		/* Call function that responsible for sending password to the Control ECU */
 		APP_sendPassword(g_password1);
 
-		LCD_clearScreen();
-		LCD_displayStringRowColumn(0, 2, "PASSWORD MATCHED");
+		SCREEN_display(SCREEN_PASSWORD_MATCHED);
 		_delay_ms(SHORT_DISPLAY_TIME);	/* Keep the message on the screen for a while */
 	}
 }
@@ -162,26 +158,17 @@ void APP_setNewPassword(uint8 a_systemStatus)
 static void APP_init(void)
 {
 	/* Display message to the user, to Enter a new password */
-	LCD_clearScreen();
-	LCD_displayStringRowColumn(0, 0, "ENTER NEW PASSWORD");
-	LCD_displayStringRowColumn(1, 0, "= : TO SUMBIT");
-	LCD_displayStringRowColumn(2, 0, "X : TO CLEAR");
-	LCD_goToRowColumn(3, 7);
+	SCREEN_display(SCREEN_ENTER_NEW_PASSWORD);
 
 	/* Call function to take the password from the user for the First time */
 	APP_getPassword(g_password1);
 
 	/* Display message to the user, that the password is submitted correctly */
-	LCD_clearScreen();
-	LCD_displayStringRowColumn(0, 1, "PASSWORD SUBMITTED");
+	SCREEN_display(SCREEN_PASSWORD_SUBMITTED);
 	_delay_ms(SHORT_DISPLAY_TIME);	/* Keep the message on the screen for a while */
 
 	/* Display message to the user, to ReEnter the same password */
-	LCD_clearScreen();
-	LCD_displayStringRowColumn(0, 0, "REENTER PASS AGAIN");
-	LCD_displayStringRowColumn(1, 0, "= : TO SUMBIT");
-	LCD_displayStringRowColumn(2, 0, "X : TO CLEAR");
-	LCD_goToRowColumn(3, 7);
+	SCREEN_display(SCREEN_REENTER_PASSWORD);
 
 	/* Call function to take the password from the user for the Second time */
 	APP_getPassword(g_password2);
@@ -192,7 +179,7 @@ static void APP_init(void)
  *
  * [Description]: Function to get password from the User
  *		  - Store password consists of 5 digits in a global array
- * 	          - Give the User two options ('=' : TO SUBMIT, 'X' : TO CLEAR)
+ * 	          - Give the User two options ('=' : TO SUBMIT, hold 'X' : TO CLEAR)
  *
  * [Args]:	    Password_Ptr
  *
@@ -207,62 +194,56 @@ static void APP_init(void)
 void APP_getPassword(uint8 * Password_Ptr)
 {
 	static uint8 counter; /* Local variable used as a counter for the for Loop */
-	static uint8 key;	  /* Local variable used to store the value of the pressed Button */
+	static KeyPad_EventType event;	/* Local variable used to store the key event */
 
 	for(counter = 0; counter < PASSWORD_WIDTH ;counter++)
 	{
-		key = KeyPad_getPressedKey();
-
-		/* Check if the Button pressed is a digit or not */
-		if(key >= 0 && key <= 9)
-		{
-			Password_Ptr[counter] = key; /* Store only digits from (0 -> 9) in the Password */
-		}
+		KeyPad_waitEvent(&event);
 
 		/*
-		 * Check if the Button pressed is equal to 'X' or not, in Case equal to 'X' clear the
+		 * Check if the Button 'X' is held or not, in Case it is held clear the
 		 * written password and restart write it again
 		 * (User Enter a wrong digit and need to correct it)
 		 */
-		else if(key == '*')
+		if((event.edge == KEYPAD_LONG_PRESSED) && (event.key == '*'))
 		{
 			counter = -1;	/* Reset the counter */
 			/* Clear Row in LCD by writing spaces " " */
-			LCD_displayStringRowColumn(3, 7,"         ");
+			SCREEN_clearPassword();
 			continue;
 		}
 
-		/* Check if the Button Pressed is not digit, decrement the counter */
-		else
+		/* Check if the event is not a press of a digit, decrement the counter */
+		else if((event.edge != KEYPAD_PRESSED) || (event.key > 9))
 		{
 			--counter;
 			continue;
 		}
 
-		_delay_ms(PRESS_TIME); /* Press Time */
-		LCD_goToRowColumn(3, counter+7);
-		LCD_displayCharacter('*');	/* Display '*' for Security issue */
+		Password_Ptr[counter] = event.key; /* Store only digits from (0 -> 9) in the Password */
+
+		SCREEN_displayPasswordDigit(counter);	/* Display '*' for Security issue */
 
 		/*
 		 * This while loop used to handle two cases:
 		 * 	- If the Button Pressed is equal to '=', break the while loop, then submit the Password
-		 * 	- If the Button Pressed is equal to 'X' (in case of 5 digits are written in the screen),
+		 * 	- If the Button 'X' is held (in case of 5 digits are written in the screen),
 		 * 	  clear the written password, then break the while loop and restart write the Correct
 		 * 	  Password again (User Enter a wrong digit and need to correct it)
 		 */
 		while(counter == 4)
 		{
-			key = KeyPad_getPressedKey(); /* Get the next Press */
+			KeyPad_waitEvent(&event); /* Get the next key event */
 
-			if(key == '=')
+			if((event.edge == KEYPAD_PRESSED) && (event.key == '='))
 			{
 				break;
 			}
-			else if(key == '*')
+			else if((event.edge == KEYPAD_LONG_PRESSED) && (event.key == '*'))
 			{
 				counter = -1;	/* Reset the counter */
 				/* Clear Row in LCD by writing spaces " " */
-				LCD_displayStringRowColumn(3, 7,"         ");
+				SCREEN_clearPassword();
 				continue;
 			}
 		}
@@ -331,9 +312,7 @@ uint8 APP_getUserDecision(void)
 	 * 	"+" : TO CHANGE PASSWORD
 	 * 	"-" : TO OPEN DOOR
 	 */
-	LCD_clearScreen();
-	LCD_displayStringRowColumn(0, 0, "+ : CHANGE PASSWORD");
-	LCD_displayStringRowColumn(1, 0, "- : OPEN DOOR");
+	SCREEN_display(SCREEN_MAIN_MENU);
 
 	/*
 	 * Take choice from the user once at least, then check if it is not equal to one of the given
@@ -345,8 +324,7 @@ uint8 APP_getUserDecision(void)
 	 */
 	do
 	{
-		key = KeyPad_getPressedKey();
-		_delay_ms(PRESS_TIME);	/* Press Time */
+		key = KeyPad_getPressedKey();	/* One key for each press */
 
 	}while(key != CHANGE_PASSWORD && key != DOOR_OPEN);
 
@@ -419,8 +397,7 @@ void APP_incorrectPassword(void)
 {
 	++g_wrongAttempts;	/* Increment the number of wrong choice */
 
-	LCD_clearScreen();
-	LCD_displayStringRowColumn(0, 1, "INCORRECT PASSWORD");
+	SCREEN_display(SCREEN_INCORRECT_PASSWORD);
 	_delay_ms(SHORT_DISPLAY_TIME);	/* Keep the message on the screen for a while */
 
 	/*
@@ -429,11 +406,7 @@ void APP_incorrectPassword(void)
 	 */
 	if(g_wrongAttempts == MAXIMUM_ATTEMPTS-1)
 	{
-		LCD_clearScreen();
-		LCD_displayStringRowColumn(0, 0, "AFTER 1 MORE FAILED");
-		LCD_displayStringRowColumn(1, 0, "ATTEMPT SYSTEM WILL");
-		LCD_displayStringRowColumn(2, 2, "BE LOCKED FOR 15");
-		LCD_displayStringRowColumn(3, 6, "SECONDS");
+		SCREEN_display(SCREEN_LAST_ATTEMPT);
 		_delay_ms(LONG_DISPLAY_TIME);
 	}
 
@@ -443,10 +416,7 @@ void APP_incorrectPassword(void)
 	 */
 	if(g_wrongAttempts < MAXIMUM_ATTEMPTS)
 	{
-		LCD_clearScreen();
-		LCD_displayStringRowColumn(0, 0, "ENTER PASSWORD AGAIN");
-		LCD_displayStringRowColumn(1, 0, "= : TO SUMBIT");
-		LCD_displayStringRowColumn(2, 0, "X : TO CLEAR");
+		SCREEN_display(SCREEN_ENTER_PASSWORD_AGAIN);
 	}
 
 	/*
@@ -455,9 +425,7 @@ void APP_incorrectPassword(void)
 	 */
 	if(g_wrongAttempts == MAXIMUM_ATTEMPTS)
 	{
-		LCD_clearScreen();
-		LCD_displayStringRowColumn(0, 1, "MAXIMUM NUMBER OF");
-		LCD_displayStringRowColumn(1, 1, "ATTEMPTS EXCEEDED");
+		SCREEN_display(SCREEN_MAXIMUM_ATTEMPTS);
 		_delay_ms(SHORT_DISPLAY_TIME);
 
 		/* TIMER Driver Configurations */
@@ -473,8 +441,7 @@ void APP_incorrectPassword(void)
 		TIMER_init(&TIMER_Config);
 
 		/* Display message to the */
-		LCD_clearScreen();
-		LCD_displayStringRowColumn(1, 2, "SYSTEM IS LOCKED");
+		SCREEN_display(SCREEN_SYSTEM_LOCKED);
 
 		/* Wait until the alarm turned off */
 		while(g_lockSystem != OPENED){}
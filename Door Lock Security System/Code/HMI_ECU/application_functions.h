@@ -19,6 +19,9 @@
 #include "timer.h"
 #include "uart.h"
 #include "lcd.h"
+#include "lcd_frame.h"
+#include "messages.h"
+#include "screens.h"
 #include "keypad.h"
 
 /********************************************************************************
@@ -49,7 +52,6 @@
 #define CHANGE_PASSWORD     	43 		/* ACII Code for '+' */
 #define DOOR_OPEN               45		/* ACII Code for '-' */
 
-#define PRESS_TIME              350		/* Time taken for each press */
 #define LONG_DISPLAY_TIME       800		/* Long Time taken for displaying message in the screen */
 #define SHORT_DISPLAY_TIME      500		/* Short Time taken for displaying message in the screen */
 
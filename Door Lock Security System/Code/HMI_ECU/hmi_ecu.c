@@ -81,6 +81,7 @@ int main(void)
 	 ********************************************************************************/
 
 	LCD_init(); /* LCD Driver Initialization */
+	LCD_FRAME_init(); /* LCD Frame Buffer Initialization */
 
 	/* UART Driver Configurations */
 	UART_ConfigType UART_Config = {BPS_9600,DOUBLE_SPEED,EIGHT_BITS,DISABLED,ONE_BIT};
@@ -88,8 +89,15 @@ int main(void)
 	/* TIMER Driver Configurations */
 	TIMER_ConfigType TIMER_Config = {INITIAL_VALUE,COUNT_ONE_SECOND,TIMER_1,COMPARE,T1_F_CPU_1024};
 
+	/* TIMER0 generates the keypad scan tick */
+	TIMER_ConfigType KEYPAD_TIMER_Config = {INITIAL_VALUE,KEYPAD_TICK_COMPARE,TIMER_0,COMPARE,T0_F_CPU_64};
+
 	UART_init(&UART_Config); 	/* UART Driver Initialization */
 
+	KeyPad_init();			/* Keypad Driver Initialization */
+	TIMER_setCallBack(KeyPad_scan, TIMER_0);
+	TIMER_init(&KEYPAD_TIMER_Config);
+
 	SREG |= (1 << 7);		/* Enable Global Interrupt, I-bit in SREG register */
 
 	UART_sendByte(ECU_READY);	/* Check if the Control ECU is ready */
@@ -138,9 +146,7 @@ int main(void)
 		while(UART_recieveByte() != ECU_READY){}	/* Wait until Control ECU be ready */
 		UART_sendByte(g_choice);			/* Send the user choice to the Control ECU */
 
-		LCD_clearScreen();	/* Display message to the user to enter the current password */
-		LCD_displayStringRowColumn(0, 4, "ENTER CURRENT");
-		LCD_displayStringRowColumn(1, 6, "PASSWORD");
+		SCREEN_display(SCREEN_ENTER_CURRENT_PASSWORD);	/* Display message to the user to enter the current password */
 
 
 		/********************************************************************************
@@ -271,8 +277,7 @@ int main(void)
 					TIMER_init(&TIMER_Config);
 
 					/* Display message to the user, that the door is opening */
-					LCD_clearScreen();
-					LCD_displayStringRowColumn(1, 2, "DOOR IS OPENING");
+					SCREEN_display(SCREEN_DOOR_IS_OPENING);
 
 					/* Wait until the system open again */
 					while(g_lockSystem != OPENED){}
@@ -294,8 +299,7 @@ int main(void)
 					TIMER_init(&TIMER_Config);
 
 					/* Display message to the user, that the door open */
-					LCD_clearScreen();
-					LCD_displayStringRowColumn(1, 5, "DOOR OPEN");
+					SCREEN_display(SCREEN_DOOR_OPEN);
 
 					/* Wait until the system open again */
 					while(g_lockSystem != OPENED){}
@@ -317,15 +321,13 @@ int main(void)
 					TIMER_init(&TIMER_Config);
 
 					/* Display message to the user, that the door is closing */
-					LCD_clearScreen();
-					LCD_displayStringRowColumn(1, 3, "DOOR IS CLOSING");
+					SCREEN_display(SCREEN_DOOR_IS_CLOSING);
 
 					/* Wait until the system open again */
 					while(g_lockSystem != OPENED){}
 
 					/* Display message to the user, that the door closed */
-					LCD_clearScreen();
-					LCD_displayStringRowColumn(1, 5, "DOOR CLOSED");
+					SCREEN_display(SCREEN_DOOR_CLOSED);
 					_delay_ms(SHORT_DISPLAY_TIME);
 
 					/* Reset the lock system status to its initial value (SYSTEM UNLOCKED) */
@@ -11,116 +11,489 @@
  *******************************************************************************/
 
 #include "keypad.h"
+#include <avr/pgmspace.h>
+#ifdef KEYPAD_STANDBY
+#include <avr/sleep.h>
+#endif
 
 /*******************************************************************************
- *                      Functions Prototypes(Private)                          *
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* The rows are the lowest 4 pins of the port and the columns the highest 4 pins */
+#define KEYPAD_ROWS_MASK 0x0F
+#define KEYPAD_FIRST_COLUMN 0b00010000
+#define KEYPAD_COLUMNS_MASK 0xF0
+
+#if (KEYPAD_DEBOUNCE_SCANS != 4)
+#error "The 2-bit debounce counters accept a new key state after 4 scans"
+#endif
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
  *******************************************************************************/
 
+/* Key event in the queue, the keys are stored as key numbers and mapped when taken */
+typedef struct
+{
+	uint8 edge;
+	uint8 key;
+	uint8 key2;
+	uint16 time;
+}KeyPad_EntryType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Key value of each switch (row * N_col + col) as it is labelled in the proteus keypad */
 #if (N_col == 3)
+static const uint8 g_keyMap[N_row * N_col] PROGMEM =
+{
+	1,   2, 3,
+	4,   5, 6,
+	7,   8, 9,
+	'*', 0, '#'
+};
+#elif (N_col == 4)
+static const uint8 g_keyMap[N_row * N_col] PROGMEM =
+{
+	7,  8, 9,   '%',
+	4,  5, 6,   '*',
+	1,  2, 3,   '-',
+	13, 0, '=', '+'	/* 13: ASCII of Enter */
+};
+#endif
+
+/* Column driven low since the previous tick, its rows are read in the current tick */
+static uint8 g_column = 0;
+
 /*
- * Description: Function responsible for mapping the switch number in the keypad to
- * its corresponding functional number in the proteus for 4x3 keypad
+ * Per column bitmaps, bit (row) of each byte belongs to the key (row, col):
+ * g_raw: last sample of the rows
+ * g_state: debounced state, set while the key is pressed
+ * g_count0, g_count1: 2-bit vertical counters of consecutive samples different from g_state
  */
-static uint8 KeyPad_4x3_adjustKeyNumber(uint8 button_number);
-#elif (N_col == 4)
+static uint8 g_raw[N_col];
+static uint8 g_state[N_col];
+static uint8 g_count0[N_col];
+static uint8 g_count1[N_col];
+
+/* Columns whose sample is ignored for presses because of a ghost key */
+static volatile uint8 g_ghostColumns = 0;
+
+#ifdef KEYPAD_STANDBY
+/* Number of ticks since a key was down (saturated at KEYPAD_STANDBY_TIME) */
+static volatile uint8 g_idleTicks = 0;
+
+/* Set after a wake up until the first key is accepted */
+static volatile uint8 g_wokenUp = FALSE;
+#endif
+
+/* Time of the current tick in ms */
+static uint16 g_time = 0;
+
+/* Last key pressed while it is still held (KEYPAD_NO_KEY if none) and its press time */
+static uint8 g_heldKey = KEYPAD_NO_KEY;
+static uint16 g_heldPressTime = 0;
+
+/* Time the held key has been down, it stops at KEYPAD_LONG_PRESS_TIME */
+static uint16 g_heldTime = 0;
+
+/* Time left before the next KEYPAD_REPEATED event of the held key */
+static uint16 g_repeatCountdown = 0;
+
+/* Auto-repeat configuration in ms */
+static volatile uint16 g_repeatDelay = KEYPAD_REPEAT_DELAY;
+static volatile uint16 g_repeatPeriod = KEYPAD_REPEAT_PERIOD;
+
+/*
+ * The scan (ISR) only moves the head and KeyPad_poll only moves the tail,
+ * each index is a single byte so no critical section is needed
+ */
+static volatile KeyPad_EntryType g_events[KEYPAD_EVENTS_SIZE];
+static volatile uint8 g_eventsHead = 0;
+static volatile uint8 g_eventsTail = 0;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for driving one column low and the others as inputs
+ * with the rows pull up resistors enabled
+ */
+static void KeyPad_selectColumn(uint8 col);
+
+/*
+ * Function responsible for adding the events of the keys that changed state in
+ * one column and following the held key
+ */
+static void KeyPad_addEvents(uint8 col,uint8 changed);
+
+/*
+ * Function responsible for giving the long press and the auto-repeat events of
+ * the held key, called every tick
+ */
+static void KeyPad_holdTick(void);
+
 /*
- * Description: Function responsible for mapping the switch number in the keypad to
- * its corresponding functional number in the proteus for 4x4 keypad
+ * Function responsible for adding one event to the queue, the event is lost if
+ * the queue is full
  */
-static uint8 KeyPad_4x4_adjustKeyNumber(uint8 button_number);
+static void KeyPad_addEvent(uint8 edge,uint8 key,uint8 key2);
+
+/*******************************************************************************
+ *                          ISR's Definitions                                  *
+ *******************************************************************************/
+
+#ifdef KEYPAD_USE_TIMER0
+ISR(TIMER0_COMP_vect)
+{
+	KeyPad_scan();
+}
+#endif
+
+#ifdef KEYPAD_STANDBY
+ISR(INT2_vect)
+{
+	/* A key woke up the MCU, the keypad is scanned again so INT2 is not needed */
+	GICR &= ~(1<<INT2);
+}
 #endif
 
 /*******************************************************************************
  *                      Functions Definitions                                  *
  *******************************************************************************/
-uint8 KeyPad_getPressedKey(void){
-	uint8 col,row;
-	while(1)
+
+void KeyPad_init(void)
+{
+	uint8 col;
+
+	for(col = 0; col < N_col; col++)
+	{
+		g_raw[col] = 0;
+		g_state[col] = 0;
+		g_count0[col] = 0;
+		g_count1[col] = 0;
+	}
+	g_ghostColumns = 0;
+	g_heldKey = KEYPAD_NO_KEY;
+	g_eventsHead = 0;
+	g_eventsTail = 0;
+
+	g_column = 0;
+	KeyPad_selectColumn(g_column);
+
+#ifdef KEYPAD_STANDBY
+	g_idleTicks = 0;
+	g_wokenUp = FALSE;
+	DDRB &= ~(1<<PB2);	/* Configure INT2/PB2 as input pin */
+	PORTB |= (1<<PB2);	/* Enable its internal pull up resistor, the diodes pull it low */
+	SET_BIT(KEYPAD_STANDBY_TEST_PORT_DIR,KEYPAD_STANDBY_TEST_PIN);
+	SET_BIT(KEYPAD_STANDBY_TEST_PORT,KEYPAD_STANDBY_TEST_PIN);
+#endif
+
+#ifdef KEYPAD_USE_TIMER0
+	/*
+	 * Configure TIMER0 in CTC mode (WGM01 = 1) with F_CPU/64 (CS01 = 1 & CS00 = 1)
+	 * and enable its compare match interrupt
+	 */
+	TCNT0 = 0;
+	OCR0 = KEYPAD_TICK_COMPARE;
+	TCCR0 = (1<<FOC0) | (1<<WGM01) | (1<<CS01) | (1<<CS00);
+	TIMSK |= (1<<OCIE0);
+	SREG |= (1<<7);	/* Enable interrupts by setting I-bit */
+#endif
+}
+
+void KeyPad_scan(void)
+{
+	uint8 col = g_column;
+	uint8 sample;
+	uint8 shared;
+	uint8 delta;
+	uint8 toggle;
+	uint8 other;
+
+	g_time += KEYPAD_TICK_TIME;
+
+	/*
+	 * The column was selected in the previous tick, so the rows had a whole tick to
+	 * settle through the pull up resistors, a pressed key reads 0
+	 */
+	sample = (~KEYPAD_PORT_IN) & KEYPAD_ROWS_MASK;
+	g_raw[col] = sample;
+
+	/*
+	 * Without diodes, 3 keys pressed on the corners of a rectangle (2 rows of 2 columns)
+	 * also connect the 4th corner, so when this column shares 2 or more pressed rows with
+	 * another column the keys can not be told apart: no new press is accepted in this
+	 * column until the rectangle is broken, releases are still accepted
+	 */
+	CLEAR_BIT(g_ghostColumns,col);
+	for(other = 0; other < N_col; other++)
 	{
-		for(col=0;col<N_col;col++) /* Loop for columns */
+		shared = g_raw[other] & sample;
+		if((other != col) && (shared & (shared - 1)))
 		{
-			/* 
-			 * Each time only one of the column pins will be output and 
-			 * the rest will be input pins include the row pins 
-			 */ 
-			KEYPAD_PORT_DIR = (0b00010000<<col); 
-			
-			/* 
-			 * Clear the output pin column in this trace and enable the internal 
-			 * pull up resistors for the rows pins
-			 */ 
-			KEYPAD_PORT_OUT = (~(0b00010000<<col)); 
-			for(row=0;row<N_row;row++) /* Loop for rows */
-			{
-				if(BIT_IS_CLEAR(KEYPAD_PORT_IN,row)) /* If the switch is press in this row */ 
-				{
-					#if (N_col == 3)  
-						return KeyPad_4x3_adjustKeyNumber((row*N_col)+col+1); 
-					#elif (N_col == 4)
-						return KeyPad_4x4_adjustKeyNumber((row*N_col)+col+1);
-					#endif				
-				}
-			}
+			SET_BIT(g_ghostColumns,col);
+			sample &= g_state[col];
+			break;
 		}
-	}	
+	}
+
+	/*
+	 * Debounce all the rows of the column at once with 2-bit vertical counters: a row
+	 * changes its state after 4 consecutive samples different from it, a sample equal
+	 * to the state clears its counter
+	 */
+	delta = sample ^ g_state[col];
+	g_count1[col] = (g_count1[col] ^ g_count0[col]) & delta;
+	g_count0[col] = (~g_count0[col]) & delta;
+	toggle = delta & ~(g_count0[col] | g_count1[col]);
+	g_state[col] ^= toggle;
+
+	if(toggle)
+	{
+		KeyPad_addEvents(col, toggle);
+	}
+	KeyPad_holdTick();
+
+#ifdef KEYPAD_STANDBY
+	/* The keypad is idle when no key is down or changing in any column */
+	if(g_raw[col] | g_state[col] | g_count0[col] | g_count1[col])
+	{
+		g_idleTicks = 0;
+	}
+	else if(g_idleTicks < (KEYPAD_STANDBY_TIME / KEYPAD_TICK_TIME))
+	{
+		g_idleTicks++;
+	}
+#endif
+
+	/* Select the next column now, it is read in the next tick */
+	col++;
+	if(col == N_col)
+	{
+		col = 0;
+	}
+	g_column = col;
+	KeyPad_selectColumn(col);
 }
 
-#if (N_col == 3) 
+uint8 KeyPad_poll(KeyPad_EventType * event)
+{
+	uint8 tail;
+
+	if(g_eventsTail == g_eventsHead)
+	{
+		return FALSE;	/* No key event */
+	}
+
+	tail = g_eventsTail;
+	event->edge = g_events[tail].edge;
+	event->key = pgm_read_byte(&g_keyMap[g_events[tail].key]);
+	event->key2 = (g_events[tail].key2 == KEYPAD_NO_KEY) ? KEYPAD_NO_KEY : pgm_read_byte(&g_keyMap[g_events[tail].key2]);
+	event->time = g_events[tail].time;
+	g_eventsTail = (tail + 1) & KEYPAD_EVENTS_MASK;
+	return TRUE;
+}
 
-static uint8 KeyPad_4x3_adjustKeyNumber(uint8 button_number)
+void KeyPad_waitEvent(KeyPad_EventType * event)
 {
-	switch(button_number)
+	while(!KeyPad_poll(event))
 	{
-		case 10: return '*'; /* ASCII Code of = */
-				 break;
-		case 11: return 0;
-				 break;		
-		case 12: return '#'; /* ASCII Code of + */
-				 break;
-		default: return button_number;								 						
+#ifdef KEYPAD_STANDBY
+		KeyPad_standby();	/* Nothing to do until a key is pressed */
+#endif
 	}
-} 
+}
 
-#elif (N_col == 4)
- 
-static uint8 KeyPad_4x4_adjustKeyNumber(uint8 button_number)
+uint8 KeyPad_getPressedKey(void)
 {
-	switch(button_number)
+	KeyPad_EventType event;
+
+	/* Each press gives exactly one key however long the button is held */
+	do
 	{
-		case 1: return 7; 
-			break;
-		case 2: return 8; 
-			break;
-		case 3: return 9; 
-			break;
-		case 4: return '%'; /* ASCII Code of % */
-			break;
-		case 5: return 4; 
-			break;
-		case 6: return 5;
-			break;
-		case 7: return 6; 
-			break;
-		case 8: return '*'; /* ASCII Code of '*' */
-			break;		
-		case 9: return 1; 
-			break;
-		case 10: return 2; 
-			break;
-		case 11: return 3; 
-			break;
-		case 12: return '-'; /* ASCII Code of '-' */
-			break;
-		case 13: return 13;  /* ASCII of Enter */
-			break;			
-		case 14: return 0; 
-			break;
-		case 15: return '='; /* ASCII Code of '=' */
-			break;
-		case 16: return '+'; /* ASCII Code of '+' */
-			break;
-		default: return button_number;								 						
+		KeyPad_waitEvent(&event);
+	}while(event.edge != KEYPAD_PRESSED);
+
+	return event.key;
+}
+
+void KeyPad_setRepeat(uint16 delay,uint16 period)
+{
+	/* The scan reads them in the ISR, so change them with the interrupts disabled */
+	uint8 sreg = SREG;
+	SREG &= ~(1<<7);
+	g_repeatDelay = delay;
+	g_repeatPeriod = period;
+	SREG = sreg;
+}
+
+uint8 KeyPad_isGhosting(void)
+{
+	return (g_ghostColumns != 0) ? TRUE : FALSE;
+}
+
+#ifdef KEYPAD_STANDBY
+uint8 KeyPad_standby(void)
+{
+	/* Wait for the released keys to be debounced and their events to be taken */
+	if((g_idleTicks < (KEYPAD_STANDBY_TIME / KEYPAD_TICK_TIME)) || (g_eventsTail != g_eventsHead))
+	{
+		return FALSE;
 	}
-} 
 
+	SREG &= ~(1<<7);	/* Disable interrupts, the scan must not select a column now */
+
+	/* Drive all the columns low, so any key pulls its row and INT2 low */
+	KEYPAD_PORT_DIR = KEYPAD_COLUMNS_MASK;
+	KEYPAD_PORT_OUT = KEYPAD_ROWS_MASK;
+
+	/* Trigger INT2 with the falling edge, the flag is cleared after changing the edge */
+	GICR &= ~(1<<INT2);
+	MCUCSR &= ~(1<<ISC2);
+	GIFR = (1<<INTF2);
+	GICR |= (1<<INT2);
+
+	CLEAR_BIT(KEYPAD_STANDBY_TEST_PORT,KEYPAD_STANDBY_TEST_PIN);
+
+	if(BIT_IS_SET(PINB,PB2))
+	{
+		/*
+		 * No key is pressed, sleep until INT2: the instruction after sei is always
+		 * executed before an interrupt, so the wake up can not be lost between them
+		 */
+		set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+		sleep_enable();
+		sei();
+		sleep_cpu();
+		sleep_disable();
+	}
+	else
+	{
+		GICR &= ~(1<<INT2);	/* A key is already pressed, do not sleep */
+		SREG |= (1<<7);
+	}
+
+	/* Resume the scan from the column it stopped at */
+	g_idleTicks = 0;
+	g_wokenUp = TRUE;
+	KeyPad_selectColumn(g_column);
+	return TRUE;
+}
+#endif
+
+static void KeyPad_selectColumn(uint8 col)
+{
+	/*
+	 * Each time only one of the column pins will be output and
+	 * the rest will be input pins include the row pins
+	 */
+	KEYPAD_PORT_DIR = (KEYPAD_FIRST_COLUMN<<col);
+
+	/*
+	 * Clear the output pin column in this trace and enable the internal
+	 * pull up resistors for the rows pins
+	 */
+	KEYPAD_PORT_OUT = (~(KEYPAD_FIRST_COLUMN<<col));
+}
+
+static void KeyPad_addEvents(uint8 col,uint8 changed)
+{
+	uint8 row;
+	uint8 key;
+
+	for(row = 0; row < N_row; row++)
+	{
+		if(BIT_IS_CLEAR(changed,row))
+		{
+			continue;
+		}
+
+		key = (row * N_col) + col;
+		if(BIT_IS_CLEAR(g_state[col],row))
+		{
+			KeyPad_addEvent(KEYPAD_RELEASED, key, KEYPAD_NO_KEY);
+			if(key == g_heldKey)
+			{
+				g_heldKey = KEYPAD_NO_KEY;
+			}
+			continue;
+		}
+
+		KeyPad_addEvent(KEYPAD_PRESSED, key, KEYPAD_NO_KEY);
+
+		if((g_heldKey != KEYPAD_NO_KEY) && ((uint16)(g_time - g_heldPressTime) <= KEYPAD_CHORD_TIME))
+		{
+			/* Two keys pressed together, neither of them gives long press or repeat events */
+			KeyPad_addEvent(KEYPAD_CHORD, g_heldKey, key);
+			g_heldKey = KEYPAD_NO_KEY;
+		}
+		else
+		{
+			/* The last pressed key is the one followed for the long press and the repeat */
+			g_heldKey = key;
+			g_heldPressTime = g_time;
+			g_heldTime = 0;
+			g_repeatCountdown = g_repeatDelay;
+		}
+
+#ifdef KEYPAD_STANDBY
+		if(g_wokenUp)
+		{
+			/* First key after the wake up */
+			g_wokenUp = FALSE;
+			SET_BIT(KEYPAD_STANDBY_TEST_PORT,KEYPAD_STANDBY_TEST_PIN);
+		}
 #endif
+	}
+}
+
+static void KeyPad_holdTick(void)
+{
+	if(g_heldKey == KEYPAD_NO_KEY)
+	{
+		return;
+	}
+
+	if(g_heldTime < KEYPAD_LONG_PRESS_TIME)
+	{
+		g_heldTime += KEYPAD_TICK_TIME;
+		if(g_heldTime >= KEYPAD_LONG_PRESS_TIME)
+		{
+			KeyPad_addEvent(KEYPAD_LONG_PRESSED, g_heldKey, KEYPAD_NO_KEY);
+		}
+	}
+
+	if(g_repeatPeriod != 0)
+	{
+		if(g_repeatCountdown > KEYPAD_TICK_TIME)
+		{
+			g_repeatCountdown -= KEYPAD_TICK_TIME;
+		}
+		else
+		{
+			KeyPad_addEvent(KEYPAD_REPEATED, g_heldKey, KEYPAD_NO_KEY);
+			g_repeatCountdown = g_repeatPeriod;
+		}
+	}
+}
+
+static void KeyPad_addEvent(uint8 edge,uint8 key,uint8 key2)
+{
+	uint8 head = g_eventsHead;
+	uint8 next = (head + 1) & KEYPAD_EVENTS_MASK;
+
+	if(next != g_eventsTail)
+	{
+		g_events[head].edge = edge;
+		g_events[head].key = key;
+		g_events[head].key2 = key2;
+		g_events[head].time = g_time;
+		g_eventsHead = next;
+	}
+}
@@ -0,0 +1,236 @@
+ /******************************************************************************
+ *
+ * [MODULE]: LCD FRAME BUFFER
+ *
+ * [FILE NAME]: lcd_frame.c
+ *
+ * [DESCRIPTION]: Source file for the LCD shadow frame buffer
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include "lcd_frame.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* RAM copy of the LCD content, one byte per cell (row by row) */
+static uint8 g_frame[LCD_FRAME_SIZE];
+
+/* One bit per cell, set when the cell changed since the last flush */
+static uint8 g_frameDirty[LCD_FRAME_DIRTY_SIZE];
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: LCD_FRAME_init
+ *
+ * [Description]: Function to clear the LCD and the shadow frame, so both of
+ * 		  them start with the same content (LCD must be initialized before)
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_FRAME_init(void)
+{
+	uint8 index;
+
+	for(index = 0; index < LCD_FRAME_SIZE; index++)
+	{
+		g_frame[index] = ' ';	/* The cleared LCD shows spaces */
+	}
+
+	for(index = 0; index < LCD_FRAME_DIRTY_SIZE; index++)
+	{
+		g_frameDirty[index] = 0;
+	}
+
+	LCD_clearScreen();
+}
+
+/*******************************************************************************
+ * [Function Name]: LCD_FRAME_clear
+ *
+ * [Description]: Function to fill the shadow frame with spaces, only the cells
+ * 		  that were not empty will be sent at the next flush
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_FRAME_clear(void)
+{
+	uint8 row;
+	uint8 col;
+
+	for(row = 0; row < LCD_FRAME_ROWS; row++)
+	{
+		for(col = 0; col < LCD_FRAME_COLUMNS; col++)
+		{
+			LCD_FRAME_displayCharacterRowColumn(row, col, ' ');
+		}
+	}
+}
+
+/*******************************************************************************
+ * [Function Name]: LCD_FRAME_displayCharacterRowColumn
+ *
+ * [Description]: Function to write one character in the shadow frame
+ *
+ * [Args]:	  row, col, data
+ *
+ * [in]		  row: Unsigned Character (row of the cell)
+ * 		  col: Unsigned Character (column of the cell)
+ * 		  data: Unsigned Character (character to be displayed)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_FRAME_displayCharacterRowColumn(uint8 row,uint8 col,uint8 data)
+{
+	uint8 index;
+
+	/* Ignore the cells outside the LCD */
+	if(row >= LCD_FRAME_ROWS || col >= LCD_FRAME_COLUMNS)
+	{
+		return;
+	}
+
+	index = (row * LCD_FRAME_COLUMNS) + col;
+
+	/* Mark the cell only if its content really changed */
+	if(g_frame[index] != data)
+	{
+		g_frame[index] = data;
+		SET_BIT(g_frameDirty[index >> 3], (index & 0x07));
+	}
+}
+
+/*******************************************************************************
+ * [Function Name]: LCD_FRAME_displayStringRowColumn
+ *
+ * [Description]: Function to write a string in the shadow frame starting from
+ * 		  the required position, the string is cut at the end of the row
+ *
+ * [Args]:	  row, col, Str
+ *
+ * [in]		  row: Unsigned Character (row of the first character)
+ * 		  col: Unsigned Character (column of the first character)
+ * 		  Str: Pointer to character (string to be displayed)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_FRAME_displayStringRowColumn(uint8 row,uint8 col,const char * Str)
+{
+	while((*Str != '\0') && (col < LCD_FRAME_COLUMNS))
+	{
+		LCD_FRAME_displayCharacterRowColumn(row, col, *Str);
+		Str++;
+		col++;
+	}
+}
+
+/*******************************************************************************
+ * [Function Name]: LCD_FRAME_displayStringRowColumn_P
+ *
+ * [Description]: Function to write a string stored in the flash memory in the
+ * 		  shadow frame starting from the required position, the string
+ * 		  is cut at the end of the row
+ *
+ * [Args]:	  row, col, Str
+ *
+ * [in]		  row: Unsigned Character (row of the first character)
+ * 		  col: Unsigned Character (column of the first character)
+ * 		  Str: Pointer to character (flash address of the string)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_FRAME_displayStringRowColumn_P(uint8 row,uint8 col,const char * Str)
+{
+	uint8 data;
+
+	while(((data = pgm_read_byte(Str)) != '\0') && (col < LCD_FRAME_COLUMNS))
+	{
+		LCD_FRAME_displayCharacterRowColumn(row, col, data);
+		Str++;
+		col++;
+	}
+}
+
+/*******************************************************************************
+ * [Function Name]: LCD_FRAME_flush
+ *
+ * [Description]: Function to send the changed cells of the shadow frame to the
+ * 		  LCD, each run of contiguous changed cells in a row costs a single
+ * 		  cursor set followed by its characters
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_FRAME_flush(void)
+{
+	uint8 row;
+	uint8 col;
+	uint8 index = 0;
+	uint8 inRun;	/* LCD cursor is already at the current cell */
+
+	for(row = 0; row < LCD_FRAME_ROWS; row++)
+	{
+		inRun = FALSE;	/* LCD address is not contiguous between rows */
+
+		for(col = 0; col < LCD_FRAME_COLUMNS; col++, index++)
+		{
+			if(BIT_IS_CLEAR(g_frameDirty[index >> 3], (index & 0x07)))
+			{
+				inRun = FALSE;
+				continue;
+			}
+
+			/* First changed cell of a run, move the LCD cursor once */
+			if(inRun == FALSE)
+			{
+				LCD_goToRowColumn(row, col);
+				inRun = TRUE;
+			}
+
+			/* The LCD increments its address counter after each character */
+			LCD_displayCharacter(g_frame[index]);
+			CLEAR_BIT(g_frameDirty[index >> 3], (index & 0x07));
+		}
+	}
+}
@@ -0,0 +1,153 @@
+ /******************************************************************************
+ *
+ * [MODULE]: LCD FRAME BUFFER
+ *
+ * [FILE NAME]: lcd_frame.h
+ *
+ * [DESCRIPTION]: Header file for the LCD shadow frame buffer, all writes go to
+ * 		  a RAM copy of the display and only the changed cells are sent
+ * 		  to the LCD when the frame is flushed
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef LCD_FRAME_H_
+#define LCD_FRAME_H_
+
+#include "std_types.h"
+#include "common_macros.h"
+#include "lcd.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* The frame has the geometry configured for the LCD driver */
+#define LCD_FRAME_ROWS		LCD_ROWS
+#define LCD_FRAME_COLUMNS	LCD_COLUMNS
+
+/* Number of cells in the frame and number of bytes needed for their dirty flags */
+#define LCD_FRAME_SIZE		(LCD_FRAME_ROWS * LCD_FRAME_COLUMNS)
+#define LCD_FRAME_DIRTY_SIZE	((LCD_FRAME_SIZE + 7) / 8)
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: LCD_FRAME_init
+ *
+ * [Description]: Function to clear the LCD and the shadow frame, so both of
+ * 		  them start with the same content (LCD must be initialized before)
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_FRAME_init(void);
+
+/*******************************************************************************
+ * [Function Name]: LCD_FRAME_clear
+ *
+ * [Description]: Function to fill the shadow frame with spaces, only the cells
+ * 		  that were not empty will be sent at the next flush
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_FRAME_clear(void);
+
+/*******************************************************************************
+ * [Function Name]: LCD_FRAME_displayCharacterRowColumn
+ *
+ * [Description]: Function to write one character in the shadow frame
+ *
+ * [Args]:	  row, col, data
+ *
+ * [in]		  row: Unsigned Character (row of the cell)
+ * 		  col: Unsigned Character (column of the cell)
+ * 		  data: Unsigned Character (character to be displayed)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_FRAME_displayCharacterRowColumn(uint8 row,uint8 col,uint8 data);
+
+/*******************************************************************************
+ * [Function Name]: LCD_FRAME_displayStringRowColumn
+ *
+ * [Description]: Function to write a string in the shadow frame starting from
+ * 		  the required position, the string is cut at the end of the row
+ *
+ * [Args]:	  row, col, Str
+ *
+ * [in]		  row: Unsigned Character (row of the first character)
+ * 		  col: Unsigned Character (column of the first character)
+ * 		  Str: Pointer to character (string to be displayed)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_FRAME_displayStringRowColumn(uint8 row,uint8 col,const char * Str);
+
+/*******************************************************************************
+ * [Function Name]: LCD_FRAME_displayStringRowColumn_P
+ *
+ * [Description]: Function to write a string stored in the flash memory in the
+ * 		  shadow frame starting from the required position, the string
+ * 		  is cut at the end of the row
+ *
+ * [Args]:	  row, col, Str
+ *
+ * [in]		  row: Unsigned Character (row of the first character)
+ * 		  col: Unsigned Character (column of the first character)
+ * 		  Str: Pointer to character (flash address of the string)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_FRAME_displayStringRowColumn_P(uint8 row,uint8 col,const char * Str);
+
+/*******************************************************************************
+ * [Function Name]: LCD_FRAME_flush
+ *
+ * [Description]: Function to send the changed cells of the shadow frame to the
+ * 		  LCD, each run of contiguous changed cells in a row costs a single
+ * 		  cursor set followed by its characters
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_FRAME_flush(void);
+
+#endif /* LCD_FRAME_H_ */
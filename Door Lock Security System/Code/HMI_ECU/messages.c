@@ -0,0 +1,128 @@
+/******************************************************************************
+ *
+ * [MODULE]: MESSAGES
+ *
+ * [FILE NAME]: messages.c
+ *
+ * [DESCRIPTION]: Source file for the HMI messages
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include "messages.h"
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	uint8 row;		/* LCD row of the first character */
+	uint8 col;		/* LCD column of the first character */
+	const char * text;	/* Flash address of the text */
+}MSG_EntryType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Texts of the messages (flash) */
+static const char g_textFirstTimeToLogin[] PROGMEM = "FIRST TIME TO LOGIN";
+static const char g_textPasswordUnmatched[] PROGMEM = "PASSWORD UNMATCHED";
+static const char g_textTryAgain[] PROGMEM = "TRY AGAIN";
+static const char g_textPasswordMatched[] PROGMEM = "PASSWORD MATCHED";
+static const char g_textEnterNewPassword[] PROGMEM = "ENTER NEW PASSWORD";
+static const char g_textToSubmit[] PROGMEM = "= : TO SUMBIT";
+static const char g_textToClear[] PROGMEM = "HOLD X : TO CLEAR";
+static const char g_textPasswordSubmitted[] PROGMEM = "PASSWORD SUBMITTED";
+static const char g_textReenterPassword[] PROGMEM = "REENTER PASS AGAIN";
+static const char g_textClearPassword[] PROGMEM = "         ";
+static const char g_textChangePassword[] PROGMEM = "+ : CHANGE PASSWORD";
+static const char g_textOpenDoor[] PROGMEM = "- : OPEN DOOR";
+static const char g_textIncorrectPassword[] PROGMEM = "INCORRECT PASSWORD";
+static const char g_textLastAttempt1[] PROGMEM = "AFTER 1 MORE FAILED";
+static const char g_textLastAttempt2[] PROGMEM = "ATTEMPT SYSTEM WILL";
+static const char g_textLastAttempt3[] PROGMEM = "BE LOCKED FOR 15";
+static const char g_textLastAttempt4[] PROGMEM = "SECONDS";
+static const char g_textEnterPasswordAgain[] PROGMEM = "ENTER PASSWORD AGAIN";
+static const char g_textMaximumAttempts1[] PROGMEM = "MAXIMUM NUMBER OF";
+static const char g_textMaximumAttempts2[] PROGMEM = "ATTEMPTS EXCEEDED";
+static const char g_textSystemLocked[] PROGMEM = "SYSTEM IS LOCKED";
+static const char g_textEnterCurrent[] PROGMEM = "ENTER CURRENT";
+static const char g_textPassword[] PROGMEM = "PASSWORD";
+static const char g_textDoorIsOpening[] PROGMEM = "DOOR IS OPENING";
+static const char g_textDoorOpen[] PROGMEM = "DOOR OPEN";
+static const char g_textDoorIsClosing[] PROGMEM = "DOOR IS CLOSING";
+static const char g_textDoorClosed[] PROGMEM = "DOOR CLOSED";
+
+/* Messages table indexed by MSG_IdType (flash) */
+static const MSG_EntryType g_messages[MSG_COUNT] PROGMEM =
+{
+	{0, 0, g_textFirstTimeToLogin},	/* MSG_FIRST_TIME_TO_LOGIN */
+	{0, 1, g_textPasswordUnmatched},	/* MSG_PASSWORD_UNMATCHED */
+	{1, 5, g_textTryAgain},	/* MSG_TRY_AGAIN */
+	{0, 2, g_textPasswordMatched},	/* MSG_PASSWORD_MATCHED */
+	{0, 0, g_textEnterNewPassword},	/* MSG_ENTER_NEW_PASSWORD */
+	{1, 0, g_textToSubmit},	/* MSG_TO_SUBMIT */
+	{2, 0, g_textToClear},	/* MSG_TO_CLEAR */
+	{0, 1, g_textPasswordSubmitted},	/* MSG_PASSWORD_SUBMITTED */
+	{0, 0, g_textReenterPassword},	/* MSG_REENTER_PASSWORD */
+	{3, 7, g_textClearPassword},	/* MSG_CLEAR_PASSWORD */
+	{0, 0, g_textChangePassword},	/* MSG_CHANGE_PASSWORD */
+	{1, 0, g_textOpenDoor},	/* MSG_OPEN_DOOR */
+	{0, 1, g_textIncorrectPassword},	/* MSG_INCORRECT_PASSWORD */
+	{0, 0, g_textLastAttempt1},	/* MSG_LAST_ATTEMPT_1 */
+	{1, 0, g_textLastAttempt2},	/* MSG_LAST_ATTEMPT_2 */
+	{2, 2, g_textLastAttempt3},	/* MSG_LAST_ATTEMPT_3 */
+	{3, 6, g_textLastAttempt4},	/* MSG_LAST_ATTEMPT_4 */
+	{0, 0, g_textEnterPasswordAgain},	/* MSG_ENTER_PASSWORD_AGAIN */
+	{0, 1, g_textMaximumAttempts1},	/* MSG_MAXIMUM_ATTEMPTS_1 */
+	{1, 1, g_textMaximumAttempts2},	/* MSG_MAXIMUM_ATTEMPTS_2 */
+	{1, 2, g_textSystemLocked},	/* MSG_SYSTEM_LOCKED */
+	{0, 4, g_textEnterCurrent},	/* MSG_ENTER_CURRENT */
+	{1, 6, g_textPassword},	/* MSG_PASSWORD */
+	{1, 2, g_textDoorIsOpening},	/* MSG_DOOR_IS_OPENING */
+	{1, 5, g_textDoorOpen},	/* MSG_DOOR_OPEN */
+	{1, 3, g_textDoorIsClosing},	/* MSG_DOOR_IS_CLOSING */
+	{1, 5, g_textDoorClosed},	/* MSG_DOOR_CLOSED */
+};
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: MSG_display
+ *
+ * [Description]: Function to write a message in the LCD shadow frame at its
+ * 		  position, the message is read directly from the flash
+ *
+ * [Args]:	  a_id
+ *
+ * [in]		  a_id: Message ID
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void MSG_display(MSG_IdType a_id)
+{
+	uint8 row;
+	uint8 col;
+	const char * text;
+
+	if(a_id >= MSG_COUNT)
+	{
+		return;
+	}
+
+	/* The table is in the flash too, so each field is read through the LPM instruction */
+	row = pgm_read_byte(&g_messages[a_id].row);
+	col = pgm_read_byte(&g_messages[a_id].col);
+	text = (const char *)pgm_read_ptr(&g_messages[a_id].text);
+
+	LCD_FRAME_displayStringRowColumn_P(row, col, text);
+}
@@ -0,0 +1,80 @@
+/******************************************************************************
+ *
+ * [MODULE]: MESSAGES
+ *
+ * [FILE NAME]: messages.h
+ *
+ * [DESCRIPTION]: Header file for the HMI messages, all the LCD texts of the
+ * 		  application are kept in a flash table indexed by the message ID
+ * 		  so none of them is copied to the SRAM at startup
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef MESSAGES_H_
+#define MESSAGES_H_
+
+#include "std_types.h"
+#include "lcd_frame.h"
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* Each ID is one line of text with a fixed position on the LCD */
+typedef enum
+{
+	MSG_FIRST_TIME_TO_LOGIN,
+	MSG_PASSWORD_UNMATCHED,
+	MSG_TRY_AGAIN,
+	MSG_PASSWORD_MATCHED,
+	MSG_ENTER_NEW_PASSWORD,
+	MSG_TO_SUBMIT,
+	MSG_TO_CLEAR,
+	MSG_PASSWORD_SUBMITTED,
+	MSG_REENTER_PASSWORD,
+	MSG_CLEAR_PASSWORD,
+	MSG_CHANGE_PASSWORD,
+	MSG_OPEN_DOOR,
+	MSG_INCORRECT_PASSWORD,
+	MSG_LAST_ATTEMPT_1,
+	MSG_LAST_ATTEMPT_2,
+	MSG_LAST_ATTEMPT_3,
+	MSG_LAST_ATTEMPT_4,
+	MSG_ENTER_PASSWORD_AGAIN,
+	MSG_MAXIMUM_ATTEMPTS_1,
+	MSG_MAXIMUM_ATTEMPTS_2,
+	MSG_SYSTEM_LOCKED,
+	MSG_ENTER_CURRENT,
+	MSG_PASSWORD,
+	MSG_DOOR_IS_OPENING,
+	MSG_DOOR_OPEN,
+	MSG_DOOR_IS_CLOSING,
+	MSG_DOOR_CLOSED,
+	MSG_COUNT	/* Number of messages */
+}MSG_IdType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: MSG_display
+ *
+ * [Description]: Function to write a message in the LCD shadow frame at its
+ * 		  position, the message is read directly from the flash
+ *
+ * [Args]:	  a_id
+ *
+ * [in]		  a_id: Message ID
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void MSG_display(MSG_IdType a_id);
+
+#endif /* MESSAGES_H_ */
@@ -0,0 +1,133 @@
+/******************************************************************************
+ *
+ * [MODULE]: SCREENS
+ *
+ * [FILE NAME]: screens.c
+ *
+ * [DESCRIPTION]: Source file for the HMI screens
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include "screens.h"
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	uint8 count;				/* Number of messages of the screen */
+	uint8 messages[SCREEN_MAX_MESSAGES];	/* MSG_IdType of each message */
+}SCREEN_EntryType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Screens table indexed by SCREEN_IdType (flash) */
+static const SCREEN_EntryType g_screens[SCREEN_COUNT] PROGMEM =
+{
+	{1, {MSG_FIRST_TIME_TO_LOGIN}},	/* SCREEN_FIRST_TIME_TO_LOGIN */
+	{3, {MSG_ENTER_NEW_PASSWORD, MSG_TO_SUBMIT, MSG_TO_CLEAR}},	/* SCREEN_ENTER_NEW_PASSWORD */
+	{1, {MSG_PASSWORD_SUBMITTED}},	/* SCREEN_PASSWORD_SUBMITTED */
+	{3, {MSG_REENTER_PASSWORD, MSG_TO_SUBMIT, MSG_TO_CLEAR}},	/* SCREEN_REENTER_PASSWORD */
+	{2, {MSG_PASSWORD_UNMATCHED, MSG_TRY_AGAIN}},	/* SCREEN_PASSWORD_UNMATCHED */
+	{1, {MSG_PASSWORD_MATCHED}},	/* SCREEN_PASSWORD_MATCHED */
+	{2, {MSG_CHANGE_PASSWORD, MSG_OPEN_DOOR}},	/* SCREEN_MAIN_MENU */
+	{2, {MSG_ENTER_CURRENT, MSG_PASSWORD}},	/* SCREEN_ENTER_CURRENT_PASSWORD */
+	{1, {MSG_INCORRECT_PASSWORD}},	/* SCREEN_INCORRECT_PASSWORD */
+	{4, {MSG_LAST_ATTEMPT_1, MSG_LAST_ATTEMPT_2, MSG_LAST_ATTEMPT_3, MSG_LAST_ATTEMPT_4}},	/* SCREEN_LAST_ATTEMPT */
+	{3, {MSG_ENTER_PASSWORD_AGAIN, MSG_TO_SUBMIT, MSG_TO_CLEAR}},	/* SCREEN_ENTER_PASSWORD_AGAIN */
+	{2, {MSG_MAXIMUM_ATTEMPTS_1, MSG_MAXIMUM_ATTEMPTS_2}},	/* SCREEN_MAXIMUM_ATTEMPTS */
+	{1, {MSG_SYSTEM_LOCKED}},	/* SCREEN_SYSTEM_LOCKED */
+	{1, {MSG_DOOR_IS_OPENING}},	/* SCREEN_DOOR_IS_OPENING */
+	{1, {MSG_DOOR_OPEN}},	/* SCREEN_DOOR_OPEN */
+	{1, {MSG_DOOR_IS_CLOSING}},	/* SCREEN_DOOR_IS_CLOSING */
+	{1, {MSG_DOOR_CLOSED}},	/* SCREEN_DOOR_CLOSED */
+};
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: SCREEN_display
+ *
+ * [Description]: Function to clear the LCD frame, write the messages of a
+ * 		  screen and send the changed characters to the LCD
+ *
+ * [Args]:	  a_id
+ *
+ * [in]		  a_id: Screen ID
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void SCREEN_display(SCREEN_IdType a_id)
+{
+	uint8 count;
+	uint8 i;
+
+	if(a_id >= SCREEN_COUNT)
+	{
+		return;
+	}
+
+	LCD_FRAME_clear();
+	count = pgm_read_byte(&g_screens[a_id].count);
+	for(i = 0; i < count; i++)
+	{
+		MSG_display((MSG_IdType)pgm_read_byte(&g_screens[a_id].messages[i]));
+	}
+	LCD_FRAME_flush();
+}
+
+/*******************************************************************************
+ * [Function Name]: SCREEN_displayPasswordDigit
+ *
+ * [Description]: Function to echo one entered digit of the password as a '*'
+ * 		  and send it to the LCD
+ *
+ * [Args]:	  a_index
+ *
+ * [in]		  a_index: Unsigned Character (index of the digit, 0 first)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void SCREEN_displayPasswordDigit(uint8 a_index)
+{
+	/* The digit itself is never shown for security */
+	LCD_FRAME_displayCharacterRowColumn(SCREEN_PASSWORD_ROW, SCREEN_PASSWORD_COLUMN + a_index, '*');
+	LCD_FRAME_flush();
+}
+
+/*******************************************************************************
+ * [Function Name]: SCREEN_clearPassword
+ *
+ * [Description]: Function to erase the echo of the entered password on the LCD
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void SCREEN_clearPassword(void)
+{
+	/* Row of the echo written with spaces */
+	MSG_display(MSG_CLEAR_PASSWORD);
+	LCD_FRAME_flush();
+}
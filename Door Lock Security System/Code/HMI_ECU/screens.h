@@ -0,0 +1,117 @@
+/******************************************************************************
+ *
+ * [MODULE]: SCREENS
+ *
+ * [FILE NAME]: screens.h
+ *
+ * [DESCRIPTION]: Header file for the HMI screens, each screen is the list of
+ * 		  messages drawn on a cleared LCD frame, it is kept in a flash
+ * 		  table indexed by the screen ID so the application and the host
+ * 		  tests draw the same screens
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef SCREENS_H_
+#define SCREENS_H_
+
+#include "std_types.h"
+#include "lcd_frame.h"
+#include "messages.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Maximum number of messages composing one screen */
+#define SCREEN_MAX_MESSAGES	4
+
+/* Position of the first '*' of the password echo (row of MSG_CLEAR_PASSWORD) */
+#define SCREEN_PASSWORD_ROW	3
+#define SCREEN_PASSWORD_COLUMN	7
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef enum
+{
+	SCREEN_FIRST_TIME_TO_LOGIN,
+	SCREEN_ENTER_NEW_PASSWORD,
+	SCREEN_PASSWORD_SUBMITTED,
+	SCREEN_REENTER_PASSWORD,
+	SCREEN_PASSWORD_UNMATCHED,
+	SCREEN_PASSWORD_MATCHED,
+	SCREEN_MAIN_MENU,
+	SCREEN_ENTER_CURRENT_PASSWORD,
+	SCREEN_INCORRECT_PASSWORD,
+	SCREEN_LAST_ATTEMPT,
+	SCREEN_ENTER_PASSWORD_AGAIN,
+	SCREEN_MAXIMUM_ATTEMPTS,
+	SCREEN_SYSTEM_LOCKED,
+	SCREEN_DOOR_IS_OPENING,
+	SCREEN_DOOR_OPEN,
+	SCREEN_DOOR_IS_CLOSING,
+	SCREEN_DOOR_CLOSED,
+	SCREEN_COUNT	/* Number of screens */
+}SCREEN_IdType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: SCREEN_display
+ *
+ * [Description]: Function to clear the LCD frame, write the messages of a
+ * 		  screen and send the changed characters to the LCD
+ *
+ * [Args]:	  a_id
+ *
+ * [in]		  a_id: Screen ID
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void SCREEN_display(SCREEN_IdType a_id);
+
+/*******************************************************************************
+ * [Function Name]: SCREEN_displayPasswordDigit
+ *
+ * [Description]: Function to echo one entered digit of the password as a '*'
+ * 		  and send it to the LCD
+ *
+ * [Args]:	  a_index
+ *
+ * [in]		  a_index: Unsigned Character (index of the digit, 0 first)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void SCREEN_displayPasswordDigit(uint8 a_index);
+
+/*******************************************************************************
+ * [Function Name]: SCREEN_clearPassword
+ *
+ * [Description]: Function to erase the echo of the entered password on the LCD
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void SCREEN_clearPassword(void);
+
+#endif /* SCREENS_H_ */
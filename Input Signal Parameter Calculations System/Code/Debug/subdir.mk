@@ -4,21 +4,30 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../fmt.c \
 ../interrupt.c \
 ../lcd.c \
+../lcd_glyph.c \
 ../signal_parameters_calculation.c \
+../snapshot.c \
 ../timer.c 
 
 OBJS += \
+./fmt.o \
 ./interrupt.o \
 ./lcd.o \
+./lcd_glyph.o \
 ./signal_parameters_calculation.o \
+./snapshot.o \
 ./timer.o 
 
 C_DEPS += \
+./fmt.d \
 ./interrupt.d \
 ./lcd.d \
+./lcd_glyph.d \
 ./signal_parameters_calculation.d \
+./snapshot.d \
 ./timer.d 
 
 
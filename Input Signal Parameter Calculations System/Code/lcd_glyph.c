@@ -0,0 +1,289 @@
+ /******************************************************************************
+ *
+ * [MODULE]: LCD GLYPH
+ *
+ * [FILE NAME]: lcd_glyph.c
+ *
+ * [DESCRIPTION]: Source file for the LCD custom characters manager
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include "lcd_glyph.h"
+
+#ifdef LCD_GLYPH_USE_QUEUE
+#include "lcd_queue.h"
+#endif
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* LCD output used for the big characters, TRUE if the output is accepted */
+#ifdef LCD_GLYPH_USE_QUEUE
+#define LCD_GLYPH_goToRowColumn(row,col)	LCD_QUEUE_goToRowColumn(row,col)
+#define LCD_GLYPH_displayCharacter(data)	LCD_QUEUE_displayCharacter(data)
+#else
+#define LCD_GLYPH_goToRowColumn(row,col)	(LCD_goToRowColumn(row,col), TRUE)
+#define LCD_GLYPH_displayCharacter(data)	(LCD_displayCharacter(data), TRUE)
+#endif
+
+/* Glyphs of the big font */
+#define BIG_GLYPH_TOP		0	/* Upper bar */
+#define BIG_GLYPH_BOTTOM	1	/* Lower bar */
+#define BIG_GLYPH_BOTH		2	/* Upper and lower bars */
+#define BIG_GLYPHS		3
+
+#if defined(LCD_GLYPH_USE_QUEUE) && (LCD_GLYPH_BIG_MAX_ENTRIES > (LCD_QUEUE_SIZE - 1))
+#error "LCD_QUEUE_SIZE is too small for one big string of LCD_COLUMNS columns"
+#endif
+
+/* Cells of the big font that are not glyphs (characters of the LCD ROM) */
+#define BIG_CELL_FULL		0xFF	/* Full block */
+#define BIG_CELL_BLANK		' '
+
+/* Big characters other than the digits */
+#define BIG_MINUS		10
+#define BIG_BLANK		11
+#define BIG_CHARACTERS		12
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Pattern loaded in each CGRAM slot (NULL_PTR if the slot is empty) */
+static const uint8 * g_slotPattern[LCD_CGRAM_CHARACTERS];
+
+/* Frame in which each slot was used last */
+static uint16 g_slotFrame[LCD_CGRAM_CHARACTERS];
+
+static uint16 g_frame = 0;
+
+/* Glyph patterns of the big font, 5 pixels per row */
+static const uint8 g_bigTop[LCD_CGRAM_PATTERN_SIZE] PROGMEM =
+	{0x1F, 0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x00};
+static const uint8 g_bigBottom[LCD_CGRAM_PATTERN_SIZE] PROGMEM =
+	{0x00, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F, 0x1F};
+static const uint8 g_bigBoth[LCD_CGRAM_PATTERN_SIZE] PROGMEM =
+	{0x1F, 0x1F, 0x00, 0x00, 0x00, 0x00, 0x1F, 0x1F};
+
+static const uint8 * const g_bigGlyphs[BIG_GLYPHS] = {g_bigTop, g_bigBottom, g_bigBoth};
+
+#define T BIG_GLYPH_TOP
+#define B BIG_GLYPH_BOTTOM
+#define X BIG_GLYPH_BOTH
+#define F BIG_CELL_FULL
+#define S BIG_CELL_BLANK
+
+/* Cells of each big character: upper row left to right, then lower row */
+static const uint8 g_bigFont[BIG_CHARACTERS][LCD_GLYPH_BIG_WIDTH * LCD_GLYPH_BIG_HEIGHT] PROGMEM =
+{
+	{F, T, F,  F, B, F},	/* 0 */
+	{T, F, S,  B, F, B},	/* 1 */
+	{X, X, F,  F, B, B},	/* 2 */
+	{X, X, F,  B, B, F},	/* 3 */
+	{F, B, F,  S, S, F},	/* 4 */
+	{F, X, X,  B, B, F},	/* 5 */
+	{F, X, X,  F, B, F},	/* 6 */
+	{T, T, F,  S, S, F},	/* 7 */
+	{F, X, F,  F, B, F},	/* 8 */
+	{F, X, F,  B, B, F},	/* 9 */
+	{B, B, B,  S, S, S},	/* - */
+	{S, S, S,  S, S, S},	/* blank */
+};
+
+#undef T
+#undef B
+#undef X
+#undef F
+#undef S
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/* Function responsible for writing a pattern in a CGRAM slot */
+static uint8 LCD_GLYPH_upload(uint8 slot,const uint8 *pattern);
+
+/* Function responsible for returning the big font index of a character */
+static uint8 LCD_GLYPH_bigIndex(char data);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void LCD_GLYPH_init(void)
+{
+	uint8 i;
+
+	for(i = 0; i < LCD_CGRAM_CHARACTERS; i++)
+	{
+		g_slotPattern[i] = NULL_PTR;
+		g_slotFrame[i] = 0;
+	}
+	g_frame = 1;
+}
+
+void LCD_GLYPH_newFrame(void)
+{
+	g_frame++;
+}
+
+uint8 LCD_GLYPH_get(const uint8 *pattern)
+{
+	uint8 i;
+	uint8 slot = LCD_GLYPH_FALLBACK;
+	uint16 age;
+	uint16 oldest = 0;
+
+	for(i = 0; i < LCD_CGRAM_CHARACTERS; i++)
+	{
+		if(g_slotPattern[i] == pattern)
+		{
+			g_slotFrame[i] = g_frame;	/* Already loaded, nothing is sent to the LCD */
+			return i;
+		}
+
+		/* Choose an empty slot first, otherwise the least recently used one not used in this frame */
+		age = (g_slotPattern[i] == NULL_PTR) ? 0xFFFF : (uint16)(g_frame - g_slotFrame[i]);
+		if(age > oldest)
+		{
+			oldest = age;
+			slot = i;
+		}
+	}
+
+	if(slot == LCD_GLYPH_FALLBACK)
+	{
+		return LCD_GLYPH_FALLBACK;	/* All the slots are shown in the current frame */
+	}
+
+	if(!LCD_GLYPH_upload(slot, pattern))
+	{
+		g_slotPattern[slot] = NULL_PTR;	/* The slot content is unknown, load it again next time */
+		return LCD_GLYPH_FALLBACK;
+	}
+
+	g_slotPattern[slot] = pattern;
+	g_slotFrame[slot] = g_frame;
+	return slot;
+}
+
+uint8 LCD_GLYPH_displayBigString(uint8 row,uint8 col,const char *Str)
+{
+	uint8 codes[BIG_GLYPHS];
+	uint8 needed = 0;
+	uint8 width = 0;
+	uint8 queued = TRUE;	/* Every cursor move and character was accepted */
+	uint8 cell;
+	uint8 index;
+	uint8 r;
+	uint8 c;
+	uint8 i;
+
+	/* Load the glyphs first, an upload moves the LCD cursor to the CGRAM */
+	for(i = 0; Str[i] != '\0'; i++)
+	{
+		if(Str[i] != '.')
+		{
+			index = LCD_GLYPH_bigIndex(Str[i]);
+			for(c = 0; c < (LCD_GLYPH_BIG_WIDTH * LCD_GLYPH_BIG_HEIGHT); c++)
+			{
+				cell = pgm_read_byte(&g_bigFont[index][c]);
+				if(cell < BIG_GLYPHS)
+				{
+					SET_BIT(needed, cell);
+				}
+			}
+		}
+	}
+	for(i = 0; i < BIG_GLYPHS; i++)
+	{
+		if(BIT_IS_SET(needed, i))
+		{
+			codes[i] = LCD_GLYPH_get(g_bigGlyphs[i]);
+		}
+	}
+
+	for(r = 0; r < LCD_GLYPH_BIG_HEIGHT; r++)
+	{
+		if(!LCD_GLYPH_goToRowColumn(row + r, col))
+		{
+			queued = FALSE;
+		}
+		width = 0;
+
+		for(i = 0; Str[i] != '\0'; i++)
+		{
+			if(Str[i] == '.')
+			{
+				/* The decimal point takes one column and no separator */
+				if(!LCD_GLYPH_displayCharacter((r == (LCD_GLYPH_BIG_HEIGHT - 1)) ? '.' : ' '))
+				{
+					queued = FALSE;
+				}
+				width++;
+				continue;
+			}
+
+			if((i > 0) && (Str[i - 1] != '.'))
+			{
+				/* Separator between two big characters */
+				if(!LCD_GLYPH_displayCharacter(' '))
+				{
+					queued = FALSE;
+				}
+				width++;
+			}
+
+			index = LCD_GLYPH_bigIndex(Str[i]);
+			for(c = 0; c < LCD_GLYPH_BIG_WIDTH; c++)
+			{
+				cell = pgm_read_byte(&g_bigFont[index][(r * LCD_GLYPH_BIG_WIDTH) + c]);
+				if(!LCD_GLYPH_displayCharacter((cell < BIG_GLYPHS) ? codes[cell] : cell))
+				{
+					queued = FALSE;
+				}
+			}
+			width += LCD_GLYPH_BIG_WIDTH;
+		}
+	}
+
+	return queued ? width : 0;
+}
+
+static uint8 LCD_GLYPH_upload(uint8 slot,const uint8 *pattern)
+{
+#ifdef LCD_GLYPH_USE_QUEUE
+	uint8 i;
+
+	if(!LCD_QUEUE_sendCommand(SET_CGRAM_ADDRESS | (slot << 3)))
+	{
+		return FALSE;
+	}
+	for(i = 0; i < LCD_CGRAM_PATTERN_SIZE; i++)
+	{
+		if(!LCD_QUEUE_displayCharacter(pgm_read_byte(&pattern[i])))
+		{
+			return FALSE;
+		}
+	}
+#else
+	LCD_setCgramPattern_P(slot, pattern);
+#endif
+	return TRUE;
+}
+
+static uint8 LCD_GLYPH_bigIndex(char data)
+{
+	if((data >= '0') && (data <= '9'))
+	{
+		return data - '0';
+	}
+	else if(data == '-')
+	{
+		return BIG_MINUS;
+	}
+	return BIG_BLANK;
+}
@@ -15,22 +15,37 @@
  * 			- MCU : ATmega 16 (F_CPU = 1 MHZ).
  *			- Use Timer1 Overflow Mode (NO_Prescaler).
  *			- Use External Interrupt0 (INT0), to enter the input Signal into MCU.
- *			- Display result on LCD (2 * 16) in PORTC.
+ *			- Display result on LCD (2 * 16) in PORTC in big digits.
+ *
+ * 			Note: The signal is measured continuously, the interrupt publishes
+ * 			the 3 Timer1 values of each measurement together with a sequence
+ * 			counter (snapshot module), so the main loop never reads values of 2
+ * 			different measurements and never disables the interrupts to read them.
  *
  *******************************************************************************************/
 
 #include "interrupt.h"
+#include "fmt.h"
 #include "lcd.h"
+#include "lcd_glyph.h"
 #include "timer.h"
+#include "snapshot.h"
 
 /*****************************************************************************************
  *                   	  	      Global Variables                                   *
  *****************************************************************************************/
 
 uint8 g_edgeCount = 0;
-uint16 g_timeHigh = 0;
-uint16 g_timePeriod = 0;
-uint16 g_timePeriodPlusHigh = 0;
+
+/* Timer1 values of the measurement in progress, used by the interrupt only */
+static uint16 g_captureHigh = 0;
+static uint16 g_capturePeriod = 0;
+
+/* Last complete measurement, written between SNAPSHOT_WRITE_BEGIN and SNAPSHOT_WRITE_END */
+volatile uint16 g_timeHigh = 0;
+volatile uint16 g_timePeriod = 0;
+volatile uint16 g_timePeriodPlusHigh = 0;
+SNAPSHOT_SequenceType g_timeSequence = 0;
 
 /*******************************************************************************************
  * [Function Name]: APP_measure_Duty_Cycle
@@ -66,25 +81,31 @@ void APP_measure_Duty_Cycle(void)
 	else if(g_edgeCount == 2)
 	{
 		/* Store the High time value */
-		g_timeHigh = TIMER1_getTimerValue();
+		g_captureHigh = TIMER1_getTimerValue();
 		/* Detect rising edge */
 		SET_BIT(MCUCR,ISC00);
 	}
 	else if(g_edgeCount == 3)
 	{
 		/* Store the Period time value */
-		g_timePeriod = TIMER1_getTimerValue();
+		g_capturePeriod = TIMER1_getTimerValue();
 		/* Detect falling edge */
 		CLEAR_BIT(MCUCR,ISC00);
 	}
 	else if(g_edgeCount == 4)
 	{
+		/* Publish the 3 values of the measurement together */
+		SNAPSHOT_WRITE_BEGIN(g_timeSequence);
+		g_timeHigh = g_captureHigh;
+		g_timePeriod = g_capturePeriod;
 		/* Store the Period time value + High time value */
 		g_timePeriodPlusHigh = TIMER1_getTimerValue();
+		SNAPSHOT_WRITE_END(g_timeSequence);
 		/* Clear the timer counter register to start measurements again */
 		TIMER1_clearTimerValue();
-		/* Detect rising edge */
+		/* Detect rising edge, the next one starts a new measurement */
 		SET_BIT(MCUCR,ISC00);
+		g_edgeCount = 0;
 	}
 }
 
@@ -98,7 +119,16 @@ int main(void)
 	 *                           SYSTEM INITIALIZATION                              *
 	 ********************************************************************************/
 
-	uint32 dutyCycle = 0;
+	uint32 dutyCycle = 0;	/* Duty cycle in tenths of percent */
+	uint32 shownDutyCycle = 0xFFFFFFFF;	/* Duty cycle on the LCD (none at the beginning) */
+	uint16 highTime;
+	uint16 periodTime;
+	uint16 timeHigh;
+	uint16 timePeriod;
+	uint16 timePeriodPlusHigh;
+	uint8 sequence;
+	uint8 shownSequence = 0;	/* Sequence of the last measurement read */
+	char buff[FMT_BUFFER_SIZE];
 
 	/* Enable Global Interrupt I-Bit */
 	SREG |= (1<<7);
@@ -108,6 +138,7 @@ int main(void)
 
 	/* Initialize LCD driver, Interrupt0, and Timer1 */
 	LCD_init();
+	LCD_GLYPH_init();
 	INT0_init();
 	TIMER1_overFlow_init();
 
@@ -117,16 +148,45 @@ int main(void)
 
 	while(1)
 	{
-		if(g_edgeCount == 4)
+		/*
+		 * Copy the last measurement, again if the interrupt published a new one during
+		 * the copy, the interrupts stay enabled and the measurement goes on
+		 */
+		do
+		{
+			sequence = SNAPSHOT_readBegin(&g_timeSequence);
+			timeHigh = g_timeHigh;
+			timePeriod = g_timePeriod;
+			timePeriodPlusHigh = g_timePeriodPlusHigh;
+		} while(SNAPSHOT_readRetry(&g_timeSequence, sequence));
+
+		if(sequence == shownSequence)
+		{
+			continue;	/* No new measurement */
+		}
+		shownSequence = sequence;
+
+		/* Calculate the Duty Cycle in tenths of percent, rounded to the nearest */
+		highTime = timePeriodPlusHigh - timePeriod;
+		periodTime = timePeriodPlusHigh - timeHigh;
+		if(periodTime == 0)
+		{
+			continue;	/* Not a period (no signal or a glitch), the frame is skipped */
+		}
+		dutyCycle = (((uint32)highTime * 1000) + (periodTime / 2)) / periodTime;
+
+		/* The LCD is written only when the displayed value changes */
+		if(dutyCycle != shownDutyCycle)
 		{
-			TIMER1_DeInit();	/* Disable Timer1 */
-			INT0_DeInit();		/* Disable Interrupt0 (INT0) */
-			g_edgeCount = 0;
-			LCD_displayString("Duty = ");
-			/* Calculate the Duty Cycle */
-			dutyCycle = ((float)(g_timePeriodPlusHigh-g_timePeriod) / (g_timePeriodPlusHigh - g_timeHigh)) * 100;
-			/* Display the Duty Cycle on LCD screen */
-			LCD_intgerToString(dutyCycle);
+			shownDutyCycle = dutyCycle;
+			/*
+			 * Display the Duty Cycle on LCD screen with one decimal in big digits, "100.0"
+			 * takes 15 columns so the '%' sign is written in the last column
+			 */
+			FMT_fixed(buff, dutyCycle, 1, 5, FMT_PAD_SPACE);
+			LCD_GLYPH_newFrame();
+			LCD_GLYPH_displayBigString(0, 0, buff);
+			LCD_goToRowColumn(1, LCD_COLUMNS - 1);
 			LCD_displayCharacter('%');
 		}
 	}
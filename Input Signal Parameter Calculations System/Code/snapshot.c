@@ -0,0 +1,110 @@
+ /******************************************************************************
+ *
+ * [MODULE]: SNAPSHOT
+ *
+ * [FILE NAME]: snapshot.c
+ *
+ * [DESCRIPTION]: Source file for the snapshot of variables shared between the
+ * 		  interrupts and the main loop
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include "snapshot.h"
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: SNAPSHOT_readBegin
+ *
+ * [Description]: Function to start reading shared variables that can not be
+ * 		  copied by SNAPSHOT_read (not in one block, or found from an
+ * 		  index), it waits for the end of a write in progress
+ *
+ * [Args]:	  Sequence_Ptr
+ *
+ * [in]		  Sequence_Ptr: Pointer to SNAPSHOT_SequenceType (the sequence
+ * 				changed by the writers of the variables)
+ *
+ * [out]	  Unsigned Character
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     The sequence to give to SNAPSHOT_readRetry
+ *******************************************************************************/
+unsigned char SNAPSHOT_readBegin(const SNAPSHOT_SequenceType *Sequence_Ptr)
+{
+	unsigned char sequence;
+
+	/* An odd sequence is a write in progress, wait for its end */
+	do
+	{
+		sequence = *Sequence_Ptr;
+	} while(sequence & 1);
+
+	return sequence;
+}
+
+/*******************************************************************************
+ * [Function Name]: SNAPSHOT_readRetry
+ *
+ * [Description]: Function to end reading shared variables, the values read
+ * 		  since SNAPSHOT_readBegin must be read again if it returns 1
+ *
+ * [Args]:	  Sequence_Ptr, sequence
+ *
+ * [in]		  Sequence_Ptr: Pointer to SNAPSHOT_SequenceType
+ * 		  sequence: Unsigned Character (returned by SNAPSHOT_readBegin)
+ *
+ * [out]	  Unsigned Character
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     1 if a write began during the read, otherwise 0
+ *******************************************************************************/
+unsigned char SNAPSHOT_readRetry(const SNAPSHOT_SequenceType *Sequence_Ptr,unsigned char sequence)
+{
+	/* Unchanged sequence: no write began during the read */
+	return (*Sequence_Ptr != sequence) ? 1 : 0;
+}
+
+/*******************************************************************************
+ * [Function Name]: SNAPSHOT_read
+ *
+ * [Description]: Function to copy shared variables written by interrupts, the
+ * 		  copy is done again until no write happened during it (one more
+ * 		  copy of a few bytes at most when an interrupt comes)
+ *
+ * [Args]:	  Sequence_Ptr, Copy_Ptr, Shared_Ptr, size
+ *
+ * [in]		  Sequence_Ptr: Pointer to SNAPSHOT_SequenceType (the sequence
+ * 				changed by the writers of the variables)
+ * 		  Shared_Ptr: Pointer to the shared variables (volatile)
+ * 		  size: Unsigned Character (number of bytes to copy)
+ *
+ * [out]	  Copy_Ptr: Pointer to the copy of the variables
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void SNAPSHOT_read(const SNAPSHOT_SequenceType *Sequence_Ptr,void *Copy_Ptr,
+		const volatile void *Shared_Ptr,unsigned char size)
+{
+	unsigned char *Copy_Byte_Ptr = (unsigned char *)Copy_Ptr;
+	const volatile unsigned char *Shared_Byte_Ptr = (const volatile unsigned char *)Shared_Ptr;
+	unsigned char sequence;
+	unsigned char i;
+
+	do
+	{
+		sequence = SNAPSHOT_readBegin(Sequence_Ptr);
+		for(i = 0; i < size; i++)
+		{
+			Copy_Byte_Ptr[i] = Shared_Byte_Ptr[i];
+		}
+	} while(SNAPSHOT_readRetry(Sequence_Ptr, sequence));
+}
@@ -0,0 +1,52 @@
+ /******************************************************************************
+ *
+ * [MODULE]: EMULATOR LCD
+ *
+ * [FILE NAME]: emu_lcd.c
+ *
+ * [DESCRIPTION]: Source file for connecting the HD44780 model to the pins
+ * 		  selected in the lcd_config.h of the project under test
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include "lcd.h"
+#include "hd44780.h"
+#include "emu_lcd.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Address of a register given by its avr/io.h name */
+#define EMU_LCD_ADDRESS(REG) ((uint8_t)(&(REG) - EMU_PORT_access(0)))
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void EMU_LCD_init(void)
+{
+	HD44780_WiringType wiring;
+
+	/* Taking the register addresses advances the clock, so do it before the reset */
+	wiring.ctrlPort = EMU_LCD_ADDRESS(LCD_CTRL_PORT);
+	wiring.dataPort = EMU_LCD_ADDRESS(LCD_DATA_PORT);
+	wiring.dataDir = EMU_LCD_ADDRESS(LCD_DATA_PORT_DIR);
+	wiring.dataPin = EMU_LCD_ADDRESS(LCD_DATA_PORT_IN);
+	wiring.rsBit = RS;
+	wiring.rwBit = RW;
+	wiring.eBit = E;
+	wiring.dataBits = DATA_BITS_MODE;
+#ifdef UPPER_PORT_PINS
+	wiring.dataShift = 4;
+#else
+	wiring.dataShift = 0;
+#endif
+	wiring.rows = LCD_ROWS;
+	wiring.columns = LCD_COLUMNS;
+
+	EMU_PORT_reset(F_CPU);
+	HD44780_init(&wiring);
+}
@@ -0,0 +1,27 @@
+ /******************************************************************************
+ *
+ * [MODULE]: EMULATOR LCD
+ *
+ * [FILE NAME]: emu_lcd.h
+ *
+ * [DESCRIPTION]: Header file for connecting the HD44780 model to the pins
+ * 		  selected in the lcd_config.h of the project under test
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef EMU_LCD_H_
+#define EMU_LCD_H_
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Function responsible for resetting the emulated ports at the F_CPU of the
+ * project and powering on an LCD wired as its lcd_config.h describes
+ */
+void EMU_LCD_init(void);
+
+#endif /* EMU_LCD_H_ */
@@ -0,0 +1,106 @@
+ /******************************************************************************
+ *
+ * [MODULE]: EMULATOR PORTS
+ *
+ * [FILE NAME]: emu_port.c
+ *
+ * [DESCRIPTION]: Source file for the emulated ATmega16 I/O registers
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include "emu_port.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static volatile uint8_t g_registers[EMU_REGISTERS];
+
+static EMU_PORT_SyncType g_devices[EMU_MAX_DEVICES];
+static uint8_t g_devicesCount = 0;
+
+static uint64_t g_timeNs = 0;		/* Simulated time since reset */
+static uint64_t g_cycleTimeNs = 1000;	/* Duration of one CPU cycle */
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for updating the PIN registers from the outputs and
+ * calling the device models
+ */
+static void EMU_PORT_sync(void);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void EMU_PORT_reset(uint32_t cpuFrequency)
+{
+	uint8_t address;
+
+	for(address = 0; address < EMU_REGISTERS; address++)
+	{
+		g_registers[address] = 0;
+	}
+
+	g_devicesCount = 0;
+	g_timeNs = 0;
+	g_cycleTimeNs = 1000000000ULL / cpuFrequency;
+}
+
+void EMU_PORT_attach(EMU_PORT_SyncType sync)
+{
+	if(g_devicesCount < EMU_MAX_DEVICES)
+	{
+		g_devices[g_devicesCount++] = sync;
+	}
+}
+
+volatile uint8_t * EMU_PORT_access(uint8_t address)
+{
+	g_timeNs += EMU_ACCESS_CYCLES * g_cycleTimeNs;
+	EMU_PORT_sync();
+	return &g_registers[address];
+}
+
+uint8_t EMU_PORT_peek(uint8_t address)
+{
+	return g_registers[address];
+}
+
+void EMU_PORT_poke(uint8_t address,uint8_t value)
+{
+	g_registers[address] = value;
+}
+
+void EMU_PORT_delayNs(uint64_t ns)
+{
+	g_timeNs += ns;
+	EMU_PORT_sync();
+}
+
+uint64_t EMU_PORT_getTimeNs(void)
+{
+	return g_timeNs;
+}
+
+static void EMU_PORT_sync(void)
+{
+	uint8_t port;
+	uint8_t i;
+
+	/* Output pins read back their own level, input pins read low unless a device drives them */
+	for(port = EMU_PIND; port <= EMU_PINA; port += 3)
+	{
+		g_registers[port] = g_registers[port + 2] & g_registers[port + 1];
+	}
+
+	for(i = 0; i < g_devicesCount; i++)
+	{
+		(*g_devices[i])();
+	}
+}
@@ -0,0 +1,95 @@
+ /******************************************************************************
+ *
+ * [MODULE]: EMULATOR PORTS
+ *
+ * [FILE NAME]: emu_port.h
+ *
+ * [DESCRIPTION]: Header file for the emulated ATmega16 I/O registers used to
+ * 		  build the AVR drivers on the host, every register access and
+ * 		  every delay advances the simulated clock and lets the attached
+ * 		  device models sample the pins
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef EMU_PORT_H_
+#define EMU_PORT_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* ATmega16 I/O addresses of the GPIO registers */
+#define EMU_PIND	0x10
+#define EMU_DDRD	0x11
+#define EMU_PORTD	0x12
+#define EMU_PINC	0x13
+#define EMU_DDRC	0x14
+#define EMU_PORTC	0x15
+#define EMU_PINB	0x16
+#define EMU_DDRB	0x17
+#define EMU_PORTB	0x18
+#define EMU_PINA	0x19
+#define EMU_DDRA	0x1A
+#define EMU_PORTA	0x1B
+#define EMU_SREG	0x3F
+
+#define EMU_REGISTERS	0x40
+
+/* Number of CPU cycles charged for each register access */
+#define EMU_ACCESS_CYCLES	2
+
+/* Maximum number of device models attached to the ports */
+#define EMU_MAX_DEVICES		4
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* Device model function called before each register access and after each delay */
+typedef void (*EMU_PORT_SyncType)(void);
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Function responsible for clearing all the registers and the simulated clock
+ */
+void EMU_PORT_reset(uint32_t cpuFrequency);
+
+/*
+ * Function responsible for attaching a device model to the ports
+ */
+void EMU_PORT_attach(EMU_PORT_SyncType sync);
+
+/*
+ * Function responsible for returning the address of a register, the devices
+ * sample the pins before the access so they see the result of the previous one
+ */
+volatile uint8_t * EMU_PORT_access(uint8_t address);
+
+/*
+ * Function responsible for reading a register without any side effect (models only)
+ */
+uint8_t EMU_PORT_peek(uint8_t address);
+
+/*
+ * Function responsible for writing a register without any side effect (models only)
+ */
+void EMU_PORT_poke(uint8_t address,uint8_t value);
+
+/*
+ * Function responsible for advancing the simulated clock by a delay
+ */
+void EMU_PORT_delayNs(uint64_t ns);
+
+/*
+ * Function responsible for returning the simulated time in nano-seconds
+ */
+uint64_t EMU_PORT_getTimeNs(void);
+
+#endif /* EMU_PORT_H_ */
@@ -0,0 +1,407 @@
+ /******************************************************************************
+ *
+ * [MODULE]: HD44780 MODEL
+ *
+ * [FILE NAME]: hd44780.c
+ *
+ * [DESCRIPTION]: Source file for the HD44780 LCD controller model
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include <string.h>
+#include "emu_port.h"
+#include "hd44780.h"
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	uint8_t ddram[HD44780_DDRAM_SIZE];
+	uint8_t cgram[HD44780_CGRAM_SIZE];
+	uint8_t addressCounter;
+	uint8_t cgramSelected;		/* Address counter points to the CGRAM */
+	uint8_t increment;		/* Entry mode I/D */
+	uint8_t eightBits;		/* Function set DL */
+	uint8_t lowNibblePending;	/* 4-bit mode: the high nibble is already transferred */
+	uint8_t highNibble;
+	uint8_t readValue;		/* Byte being read in 4-bit mode */
+	uint8_t lastE;
+	uint64_t busyUntilNs;
+}HD44780_StateType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static HD44780_WiringType g_wiring;
+static HD44780_StateType g_lcd;
+static HD44780_StatsType g_stats;
+static uint64_t g_statsStartNs;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/* Function responsible for sampling the pins, called before each port access */
+static void HD44780_sync(void);
+
+/* Function responsible for executing one transferred byte */
+static void HD44780_write(uint8_t rs,uint8_t value);
+
+/* Function responsible for producing the byte read by the MCU */
+static uint8_t HD44780_read(uint8_t rs);
+
+/* Function responsible for moving the address counter after a data access */
+static void HD44780_step(void);
+
+/* Function responsible for checking if the controller is still executing */
+static uint8_t HD44780_isBusy(void);
+
+/* Function responsible for returning the DDRAM address of a visible cell */
+static uint8_t HD44780_cellAddress(uint8_t row,uint8_t col);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void HD44780_init(const HD44780_WiringType * wiring)
+{
+	g_wiring = *wiring;
+
+	memset(&g_lcd, 0, sizeof(g_lcd));
+	memset(g_lcd.ddram, ' ', sizeof(g_lcd.ddram));
+	g_lcd.increment = 1;
+	g_lcd.eightBits = 1;	/* The controller always powers up in 8-bit mode */
+	g_lcd.busyUntilNs = EMU_PORT_getTimeNs() + HD44780_POWER_ON_TIME;
+
+	HD44780_resetStats();
+	EMU_PORT_attach(HD44780_sync);
+}
+
+void HD44780_resetStats(void)
+{
+	memset(&g_stats, 0, sizeof(g_stats));
+	g_statsStartNs = EMU_PORT_getTimeNs();
+}
+
+void HD44780_getStats(HD44780_StatsType * stats)
+{
+	*stats = g_stats;
+	stats->timeNs = EMU_PORT_getTimeNs() - g_statsStartNs;
+}
+
+void HD44780_getRow(uint8_t row,char * text)
+{
+	uint8_t col;
+	uint8_t c;
+
+	for(col = 0; col < g_wiring.columns; col++)
+	{
+		c = g_lcd.ddram[HD44780_cellAddress(row, col)];
+		if(c < 0x10)
+		{
+			text[col] = '#';	/* CGRAM character */
+		}
+		else if(c < 0x20 || c > 0x7E)
+		{
+			text[col] = '?';	/* Character outside the ASCII part of the ROM */
+		}
+		else
+		{
+			text[col] = c;
+		}
+	}
+	text[col] = '\0';
+}
+
+uint8_t HD44780_getAddressCounter(void)
+{
+	return g_lcd.addressCounter;
+}
+
+uint8_t HD44780_getCgram(uint8_t address)
+{
+	return g_lcd.cgram[address % HD44780_CGRAM_SIZE];
+}
+
+void HD44780_print(FILE * stream)
+{
+	char text[HD44780_DDRAM_SIZE];
+	uint8_t row;
+	uint8_t col;
+
+	fputc('+', stream);
+	for(col = 0; col < g_wiring.columns; col++)
+	{
+		fputc('-', stream);
+	}
+	fputs("+\n", stream);
+
+	for(row = 0; row < g_wiring.rows; row++)
+	{
+		HD44780_getRow(row, text);
+		fprintf(stream, "|%s|\n", text);
+	}
+
+	fputc('+', stream);
+	for(col = 0; col < g_wiring.columns; col++)
+	{
+		fputc('-', stream);
+	}
+	fputs("+\n", stream);
+}
+
+static void HD44780_sync(void)
+{
+	uint8_t ctrl = EMU_PORT_peek(g_wiring.ctrlPort) & EMU_PORT_peek(g_wiring.ctrlPort - 1);
+	uint8_t e = (ctrl >> g_wiring.eBit) & 1;
+	uint8_t rs = (ctrl >> g_wiring.rsBit) & 1;
+	uint8_t rw = (ctrl >> g_wiring.rwBit) & 1;
+	uint8_t mask = (g_wiring.dataBits == 8) ? 0xFF : (0x0F << g_wiring.dataShift);
+	uint8_t bus;
+	uint8_t pins;
+
+	if(e && !g_lcd.lastE)
+	{
+		g_stats.enablePulses++;
+	}
+
+	if(e && rw)
+	{
+		/* The LCD drives the data pins while E is high in read mode */
+		if(!g_lcd.lastE)
+		{
+			if(g_wiring.dataBits == 8)
+			{
+				g_lcd.readValue = HD44780_read(rs);
+			}
+			else if(!g_lcd.lowNibblePending)
+			{
+				g_lcd.readValue = HD44780_read(rs);
+			}
+		}
+
+		if(g_wiring.dataBits == 8)
+		{
+			bus = g_lcd.readValue;
+		}
+		else
+		{
+			bus = (g_lcd.lowNibblePending ? g_lcd.readValue : (g_lcd.readValue >> 4)) & 0x0F;
+			bus <<= g_wiring.dataShift;
+		}
+
+		/* Only the pins configured as inputs show the LCD output */
+		pins = EMU_PORT_peek(g_wiring.dataPin);
+		pins = (pins & ~(mask & ~EMU_PORT_peek(g_wiring.dataDir))) | (bus & mask & ~EMU_PORT_peek(g_wiring.dataDir));
+		EMU_PORT_poke(g_wiring.dataPin, pins);
+	}
+
+	if(!e && g_lcd.lastE)
+	{
+		if(rw)
+		{
+			/* End of a read transfer */
+			if(g_wiring.dataBits == 4 && !g_lcd.eightBits)
+			{
+				g_lcd.lowNibblePending = !g_lcd.lowNibblePending;
+			}
+		}
+		else
+		{
+			/* The LCD latches the data pins on the falling edge of E, floating inputs read as 0 */
+			bus = EMU_PORT_peek(g_wiring.dataPort) & EMU_PORT_peek(g_wiring.dataDir);
+
+			if(g_wiring.dataBits == 4)
+			{
+				bus = ((bus >> g_wiring.dataShift) & 0x0F) << 4;	/* D3 --> D0 are not connected */
+			}
+
+			if(g_lcd.eightBits)
+			{
+				HD44780_write(rs, bus);
+			}
+			else if(!g_lcd.lowNibblePending)
+			{
+				g_lcd.highNibble = bus & 0xF0;
+				g_lcd.lowNibblePending = 1;
+			}
+			else
+			{
+				g_lcd.lowNibblePending = 0;
+				HD44780_write(rs, g_lcd.highNibble | (bus >> 4));
+			}
+		}
+	}
+
+	g_lcd.lastE = e;
+}
+
+static void HD44780_write(uint8_t rs,uint8_t value)
+{
+	uint64_t executionTime = HD44780_INSTRUCTION_TIME;
+
+	if(HD44780_isBusy())
+	{
+		g_stats.busyViolations++;
+	}
+
+	if(rs)
+	{
+		g_stats.characters++;
+		if(g_lcd.cgramSelected)
+		{
+			g_lcd.cgram[g_lcd.addressCounter & (HD44780_CGRAM_SIZE - 1)] = value;
+		}
+		else
+		{
+			g_lcd.ddram[g_lcd.addressCounter & (HD44780_DDRAM_SIZE - 1)] = value;
+		}
+		HD44780_step();
+		executionTime = HD44780_DATA_TIME;
+	}
+	else
+	{
+		g_stats.instructions++;
+		if(value & 0x80)
+		{
+			/* Set DDRAM address */
+			g_lcd.cgramSelected = 0;
+			g_lcd.addressCounter = value & 0x7F;
+		}
+		else if(value & 0x40)
+		{
+			/* Set CGRAM address */
+			g_lcd.cgramSelected = 1;
+			g_lcd.addressCounter = value & 0x3F;
+		}
+		else if(value & 0x20)
+		{
+			/* Function set, only the interface width changes the model behaviour */
+			g_lcd.eightBits = (value >> 4) & 1;
+			g_lcd.lowNibblePending = 0;
+		}
+		else if(value & 0x10)
+		{
+			/* Cursor or display shift, only the cursor move is modelled */
+			if(!(value & 0x08))
+			{
+				g_lcd.increment = (value >> 2) & 1;
+				HD44780_step();
+				g_lcd.increment = 1;
+			}
+		}
+		else if(value & 0x08)
+		{
+			/* Display on/off control does not change the memory */
+		}
+		else if(value & 0x04)
+		{
+			/* Entry mode set */
+			g_lcd.increment = (value >> 1) & 1;
+		}
+		else if(value & 0x02)
+		{
+			/* Return home */
+			g_lcd.cgramSelected = 0;
+			g_lcd.addressCounter = 0;
+			executionTime = HD44780_CLEAR_HOME_TIME;
+		}
+		else if(value & 0x01)
+		{
+			/* Clear display */
+			memset(g_lcd.ddram, ' ', sizeof(g_lcd.ddram));
+			g_lcd.cgramSelected = 0;
+			g_lcd.addressCounter = 0;
+			g_lcd.increment = 1;
+			executionTime = HD44780_CLEAR_HOME_TIME;
+		}
+	}
+
+	g_lcd.busyUntilNs = EMU_PORT_getTimeNs() + executionTime;
+}
+
+static uint8_t HD44780_read(uint8_t rs)
+{
+	uint8_t value;
+
+	if(!rs)
+	{
+		g_stats.statusReads++;
+		return (HD44780_isBusy() ? 0x80 : 0x00) | (g_lcd.addressCounter & 0x7F);
+	}
+
+	g_stats.dataReads++;
+	if(g_lcd.cgramSelected)
+	{
+		value = g_lcd.cgram[g_lcd.addressCounter & (HD44780_CGRAM_SIZE - 1)];
+	}
+	else
+	{
+		value = g_lcd.ddram[g_lcd.addressCounter & (HD44780_DDRAM_SIZE - 1)];
+	}
+	HD44780_step();
+	return value;
+}
+
+static void HD44780_step(void)
+{
+	if(g_lcd.cgramSelected)
+	{
+		g_lcd.addressCounter = (g_lcd.addressCounter + (g_lcd.increment ? 1 : -1)) & (HD44780_CGRAM_SIZE - 1);
+		return;
+	}
+
+	/* 2-line mode: each line has 40 addresses, 0x00 --> 0x27 and 0x40 --> 0x67 */
+	if(g_lcd.increment)
+	{
+		if(g_lcd.addressCounter == 0x27)
+		{
+			g_lcd.addressCounter = 0x40;
+		}
+		else if(g_lcd.addressCounter >= 0x67)
+		{
+			g_lcd.addressCounter = 0x00;
+		}
+		else
+		{
+			g_lcd.addressCounter++;
+		}
+	}
+	else
+	{
+		if(g_lcd.addressCounter == 0x40)
+		{
+			g_lcd.addressCounter = 0x27;
+		}
+		else if(g_lcd.addressCounter == 0x00)
+		{
+			g_lcd.addressCounter = 0x67;
+		}
+		else
+		{
+			g_lcd.addressCounter--;
+		}
+	}
+}
+
+static uint8_t HD44780_isBusy(void)
+{
+	return EMU_PORT_getTimeNs() < g_lcd.busyUntilNs;
+}
+
+static uint8_t HD44780_cellAddress(uint8_t row,uint8_t col)
+{
+	/* Rows 2 and 3 of a 4 lines LCD continue rows 0 and 1 after the last visible column */
+	uint8_t base = (row & 0x01) ? 0x40 : 0x00;
+
+	if(row & 0x02)
+	{
+		base += g_wiring.columns;
+	}
+	return base + col;
+}
@@ -0,0 +1,108 @@
+ /******************************************************************************
+ *
+ * [MODULE]: HD44780 MODEL
+ *
+ * [FILE NAME]: hd44780.h
+ *
+ * [DESCRIPTION]: Header file for the HD44780 LCD controller model, the model
+ * 		  decodes the E/RS/RW strobes on the emulated ports, keeps the
+ * 		  DDRAM, CGRAM and address counter and counts the bus activity
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef HD44780_H_
+#define HD44780_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+#define HD44780_DDRAM_SIZE	0x80
+#define HD44780_CGRAM_SIZE	0x40
+
+/* Execution times (datasheet at fosc = 270 KHz) in nano-seconds */
+#define HD44780_INSTRUCTION_TIME	37000
+#define HD44780_DATA_TIME		41000	/* 37us + tADD 4us */
+#define HD44780_CLEAR_HOME_TIME		1520000
+
+/* Internal reset time after power on */
+#define HD44780_POWER_ON_TIME		15000000
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* Connection of the LCD to the emulated ports */
+typedef struct
+{
+	uint8_t ctrlPort;	/* EMU_PORTx of the control pins */
+	uint8_t rsBit;
+	uint8_t rwBit;
+	uint8_t eBit;
+	uint8_t dataPort;	/* EMU_PORTx of the data pins */
+	uint8_t dataPin;	/* EMU_PINx of the data pins */
+	uint8_t dataDir;	/* EMU_DDRx of the data pins */
+	uint8_t dataBits;	/* 8: D0 --> D7 connected, 4: only D4 --> D7 connected */
+	uint8_t dataShift;	/* 4-bit mode: port bit of D4 (0 or 4) */
+	uint8_t rows;		/* Visible geometry */
+	uint8_t columns;
+}HD44780_WiringType;
+
+/* Bus activity counters */
+typedef struct
+{
+	uint32_t enablePulses;		/* Rising edges on E */
+	uint32_t instructions;		/* Instructions written */
+	uint32_t characters;		/* Data bytes written */
+	uint32_t statusReads;		/* Busy flag / address counter reads */
+	uint32_t dataReads;		/* Data bytes read */
+	uint32_t busyViolations;	/* Writes issued while the controller was busy */
+	uint64_t timeNs;		/* Simulated time since the last reset of the counters */
+}HD44780_StatsType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Function responsible for powering on the model and attaching it to the ports
+ */
+void HD44780_init(const HD44780_WiringType * wiring);
+
+/*
+ * Function responsible for clearing the bus activity counters
+ */
+void HD44780_resetStats(void);
+
+/*
+ * Function responsible for returning the bus activity since the last reset
+ */
+void HD44780_getStats(HD44780_StatsType * stats);
+
+/*
+ * Function responsible for returning the visible text of one row, CGRAM
+ * characters are shown as '#' (text must hold columns + 1 characters)
+ */
+void HD44780_getRow(uint8_t row,char * text);
+
+/*
+ * Function responsible for returning the current address counter
+ */
+uint8_t HD44780_getAddressCounter(void);
+
+/*
+ * Function responsible for returning one CGRAM byte
+ */
+uint8_t HD44780_getCgram(uint8_t address);
+
+/*
+ * Function responsible for printing the visible screen inside a frame
+ */
+void HD44780_print(FILE * stream);
+
+#endif /* HD44780_H_ */
@@ -0,0 +1,261 @@
+ /******************************************************************************
+ *
+ * [MODULE]: EMULATOR LCD
+ *
+ * [FILE NAME]: hmi_screens.c
+ *
+ * [DESCRIPTION]: Host program that runs the LCD drivers of the Door Lock HMI
+ * 		  ECU on the HD44780 model, it draws every screen through the
+ * 		  screens module the application calls and prints what the LCD
+ * 		  shows with the bus activity each screen costs, it fails if a
+ * 		  screen differs from its expected rows or if the busy flag was
+ * 		  not respected
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "lcd.h"
+#include "lcd_frame.h"
+#include "messages.h"
+#include "screens.h"
+#include "hd44780.h"
+#include "emu_lcd.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Number of digits of the password echo (PASSWORD_WIDTH of the HMI ECU) */
+#define SCREEN_PASSWORD_DIGITS 5
+
+/* Rows and columns of the HMI LCD (4 * 20), the expected rows have this length */
+#define SCREEN_ROWS 4
+#define SCREEN_COLUMNS 20
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct
+{
+	const char * name;
+	const char * rows[SCREEN_ROWS];	/* Expected text of each row */
+}SCREEN_ExpectedType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Expected rows of each screen drawn by SCREEN_display, indexed by SCREEN_IdType */
+static const SCREEN_ExpectedType g_expected[SCREEN_COUNT] =
+{
+	[SCREEN_FIRST_TIME_TO_LOGIN] = {"First time to login",
+		{"FIRST TIME TO LOGIN ",
+		 "                    ",
+		 "                    ",
+		 "                    "}},
+	[SCREEN_ENTER_NEW_PASSWORD] = {"Enter new password",
+		{"ENTER NEW PASSWORD  ",
+		 "= : TO SUMBIT       ",
+		 "HOLD X : TO CLEAR   ",
+		 "                    "}},
+	[SCREEN_PASSWORD_SUBMITTED] = {"Password submitted",
+		{" PASSWORD SUBMITTED ",
+		 "                    ",
+		 "                    ",
+		 "                    "}},
+	[SCREEN_REENTER_PASSWORD] = {"Reenter password",
+		{"REENTER PASS AGAIN  ",
+		 "= : TO SUMBIT       ",
+		 "HOLD X : TO CLEAR   ",
+		 "                    "}},
+	[SCREEN_PASSWORD_UNMATCHED] = {"Passwords unmatched",
+		{" PASSWORD UNMATCHED ",
+		 "     TRY AGAIN      ",
+		 "                    ",
+		 "                    "}},
+	[SCREEN_PASSWORD_MATCHED] = {"Passwords matched",
+		{"  PASSWORD MATCHED  ",
+		 "                    ",
+		 "                    ",
+		 "                    "}},
+	[SCREEN_MAIN_MENU] = {"Main menu",
+		{"+ : CHANGE PASSWORD ",
+		 "- : OPEN DOOR       ",
+		 "                    ",
+		 "                    "}},
+	[SCREEN_ENTER_CURRENT_PASSWORD] = {"Enter current password",
+		{"    ENTER CURRENT   ",
+		 "      PASSWORD      ",
+		 "                    ",
+		 "                    "}},
+	[SCREEN_INCORRECT_PASSWORD] = {"Incorrect password",
+		{" INCORRECT PASSWORD ",
+		 "                    ",
+		 "                    ",
+		 "                    "}},
+	[SCREEN_LAST_ATTEMPT] = {"Last attempt",
+		{"AFTER 1 MORE FAILED ",
+		 "ATTEMPT SYSTEM WILL ",
+		 "  BE LOCKED FOR 15  ",
+		 "      SECONDS       "}},
+	[SCREEN_ENTER_PASSWORD_AGAIN] = {"Enter password again",
+		{"ENTER PASSWORD AGAIN",
+		 "= : TO SUMBIT       ",
+		 "HOLD X : TO CLEAR   ",
+		 "                    "}},
+	[SCREEN_MAXIMUM_ATTEMPTS] = {"Maximum attempts",
+		{" MAXIMUM NUMBER OF  ",
+		 " ATTEMPTS EXCEEDED  ",
+		 "                    ",
+		 "                    "}},
+	[SCREEN_SYSTEM_LOCKED] = {"System locked",
+		{"                    ",
+		 "  SYSTEM IS LOCKED  ",
+		 "                    ",
+		 "                    "}},
+	[SCREEN_DOOR_IS_OPENING] = {"Door is opening",
+		{"                    ",
+		 "  DOOR IS OPENING   ",
+		 "                    ",
+		 "                    "}},
+	[SCREEN_DOOR_OPEN] = {"Door open",
+		{"                    ",
+		 "     DOOR OPEN      ",
+		 "                    ",
+		 "                    "}},
+	[SCREEN_DOOR_IS_CLOSING] = {"Door is closing",
+		{"                    ",
+		 "   DOOR IS CLOSING  ",
+		 "                    ",
+		 "                    "}},
+	[SCREEN_DOOR_CLOSED] = {"Door closed",
+		{"                    ",
+		 "     DOOR CLOSED    ",
+		 "                    ",
+		 "                    "}},
+};
+
+/* Expected rows of the steps that are not a whole screen */
+static const char * const g_powerOnRows[SCREEN_ROWS] =
+{
+	"                    ",
+	"                    ",
+	"                    ",
+	"                    "
+};
+
+static const char * const g_passwordEchoRows[SCREEN_ROWS] =
+{
+	"ENTER NEW PASSWORD  ",
+	"= : TO SUMBIT       ",
+	"HOLD X : TO CLEAR   ",
+	"       *****        "
+};
+
+static const char * const g_clearPasswordRows[SCREEN_ROWS] =
+{
+	"ENTER NEW PASSWORD  ",
+	"= : TO SUMBIT       ",
+	"HOLD X : TO CLEAR   ",
+	"                    "
+};
+
+static uint32 g_totalViolations = 0;
+static uint32 g_totalMismatches = 0;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for printing the screen and the bus activity of one step, and
+ * comparing each row of the LCD with the expected one
+ */
+static void SCREEN_report(const char * name,const char * const * rows);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(void)
+{
+	uint8 id;
+	uint8 j;
+
+	EMU_LCD_init();
+	LCD_init();
+	LCD_FRAME_init();
+	SCREEN_report("Power on", g_powerOnRows);
+
+	for(id = 0; id < SCREEN_COUNT; id++)
+	{
+		if(g_expected[id].name == NULL)
+		{
+			/* A screen added to screens.h without its expected rows */
+			g_totalMismatches++;
+			printf("MISSING expected rows of the screen %u\n\n", id);
+			continue;
+		}
+
+		HD44780_resetStats();
+		SCREEN_display((SCREEN_IdType)id);
+		SCREEN_report(g_expected[id].name, g_expected[id].rows);
+
+		if(id == SCREEN_ENTER_NEW_PASSWORD)
+		{
+			/* Password echo, one '*' per key press as in the password entry loop */
+			for(j = 0; j < SCREEN_PASSWORD_DIGITS; j++)
+			{
+				HD44780_resetStats();
+				SCREEN_displayPasswordDigit(j);
+			}
+			SCREEN_report("Password echo (last key)", g_passwordEchoRows);
+
+			HD44780_resetStats();
+			SCREEN_clearPassword();
+			SCREEN_report("Clear password", g_clearPasswordRows);
+		}
+	}
+
+	printf("Busy flag violations: %lu\n", (unsigned long)g_totalViolations);
+	printf("Screen mismatches: %lu\n", (unsigned long)g_totalMismatches);
+	if((g_totalViolations != 0) || (g_totalMismatches != 0))
+	{
+		printf("FAIL\n");
+		return 1;
+	}
+	printf("PASS\n");
+	return 0;
+}
+
+static void SCREEN_report(const char * name,const char * const * rows)
+{
+	HD44780_StatsType stats;
+	char text[SCREEN_COLUMNS + 1];
+	uint8 row;
+
+	HD44780_getStats(&stats);
+	g_totalViolations += stats.busyViolations;
+
+	printf("%s\n", name);
+	HD44780_print(stdout);
+	printf("E pulses: %lu, instructions: %lu, characters: %lu, status reads: %lu, "
+			"violations: %lu, bus time: %lu us\n\n",
+			(unsigned long)stats.enablePulses, (unsigned long)stats.instructions,
+			(unsigned long)stats.characters, (unsigned long)stats.statusReads,
+			(unsigned long)stats.busyViolations, (unsigned long)(stats.timeNs / 1000));
+
+	for(row = 0; row < SCREEN_ROWS; row++)
+	{
+		HD44780_getRow(row, text);
+		if(strcmp(text, rows[row]) != 0)
+		{
+			g_totalMismatches++;
+			printf("MISMATCH row %u: expected |%s| got |%s|\n\n", row, rows[row], text);
+		}
+	}
+}
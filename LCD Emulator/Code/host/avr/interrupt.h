@@ -0,0 +1,21 @@
+ /******************************************************************************
+ *
+ * [MODULE]: EMULATOR PORTS
+ *
+ * [FILE NAME]: interrupt.h
+ *
+ * [DESCRIPTION]: Host replacement of <avr/interrupt.h>, interrupt service
+ * 		  routines become plain functions that are never called
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef EMU_AVR_INTERRUPT_H_
+#define EMU_AVR_INTERRUPT_H_
+
+#define ISR(vector)	void vector(void); void vector(void)
+#define sei()
+#define cli()
+
+#endif /* EMU_AVR_INTERRUPT_H_ */
@@ -0,0 +1,68 @@
+ /******************************************************************************
+ *
+ * [MODULE]: EMULATOR PORTS
+ *
+ * [FILE NAME]: io.h
+ *
+ * [DESCRIPTION]: Host replacement of <avr/io.h>, the GPIO registers of the
+ * 		  ATmega16 are routed to the emulated ports
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef EMU_AVR_IO_H_
+#define EMU_AVR_IO_H_
+
+#include "emu_port.h"
+
+/* Registers */
+#define PINA	(*EMU_PORT_access(EMU_PINA))
+#define DDRA	(*EMU_PORT_access(EMU_DDRA))
+#define PORTA	(*EMU_PORT_access(EMU_PORTA))
+#define PINB	(*EMU_PORT_access(EMU_PINB))
+#define DDRB	(*EMU_PORT_access(EMU_DDRB))
+#define PORTB	(*EMU_PORT_access(EMU_PORTB))
+#define PINC	(*EMU_PORT_access(EMU_PINC))
+#define DDRC	(*EMU_PORT_access(EMU_DDRC))
+#define PORTC	(*EMU_PORT_access(EMU_PORTC))
+#define PIND	(*EMU_PORT_access(EMU_PIND))
+#define DDRD	(*EMU_PORT_access(EMU_DDRD))
+#define PORTD	(*EMU_PORT_access(EMU_PORTD))
+#define SREG	(*EMU_PORT_access(EMU_SREG))
+
+/* Pins */
+#define PA0 0
+#define PA1 1
+#define PA2 2
+#define PA3 3
+#define PA4 4
+#define PA5 5
+#define PA6 6
+#define PA7 7
+#define PB0 0
+#define PB1 1
+#define PB2 2
+#define PB3 3
+#define PB4 4
+#define PB5 5
+#define PB6 6
+#define PB7 7
+#define PC0 0
+#define PC1 1
+#define PC2 2
+#define PC3 3
+#define PC4 4
+#define PC5 5
+#define PC6 6
+#define PC7 7
+#define PD0 0
+#define PD1 1
+#define PD2 2
+#define PD3 3
+#define PD4 4
+#define PD5 5
+#define PD6 6
+#define PD7 7
+
+#endif /* EMU_AVR_IO_H_ */
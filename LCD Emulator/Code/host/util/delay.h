@@ -0,0 +1,22 @@
+ /******************************************************************************
+ *
+ * [MODULE]: EMULATOR PORTS
+ *
+ * [FILE NAME]: delay.h
+ *
+ * [DESCRIPTION]: Host replacement of <util/delay.h>, the delays advance the
+ * 		  simulated clock instead of burning CPU cycles
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef EMU_UTIL_DELAY_H_
+#define EMU_UTIL_DELAY_H_
+
+#include "emu_port.h"
+
+#define _delay_us(us)	EMU_PORT_delayNs((uint64_t)((us) * 1000.0))
+#define _delay_ms(ms)	EMU_PORT_delayNs((uint64_t)((ms) * 1000000.0))
+
+#endif /* EMU_UTIL_DELAY_H_ */
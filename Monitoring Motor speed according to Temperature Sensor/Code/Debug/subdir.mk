@@ -6,22 +6,31 @@
 C_SRCS += \
 ../adc.c \
 ../dc_motor.c \
+../fmt.c \
 ../interrupt.c \
 ../lcd.c \
+../lcd_glyph.c \
+../lcd_queue.c \
 ../monitoring_motor_speed.c 
 
 OBJS += \
 ./adc.o \
 ./dc_motor.o \
+./fmt.o \
 ./interrupt.o \
 ./lcd.o \
+./lcd_glyph.o \
+./lcd_queue.o \
 ./monitoring_motor_speed.o 
 
 C_DEPS += \
 ./adc.d \
 ./dc_motor.d \
+./fmt.d \
 ./interrupt.d \
 ./lcd.d \
+./lcd_glyph.d \
+./lcd_queue.d \
 ./monitoring_motor_speed.d 
 
 
@@ -0,0 +1,121 @@
+ /******************************************************************************
+ *
+ * [MODULE]: FORMAT
+ *
+ * [FILE NAME]: fmt.h
+ *
+ * [DESCRIPTION]: Header file for the number formatting functions, numbers are
+ * 		  converted to text in a buffer owned by the caller without any
+ * 		  division instruction or dynamic memory
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef FMT_H_
+#define FMT_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/*
+ * Size of the buffer needed by any of the formatting functions, the longest
+ * text is a sign + 10 digits + decimal point + null terminator padded to the
+ * maximum width
+ */
+#define FMT_BUFFER_SIZE		16
+#define FMT_MAX_WIDTH		(FMT_BUFFER_SIZE - 1)
+
+/* Maximum number of digits after the decimal point */
+#define FMT_MAX_DECIMALS	9
+
+/* Padding characters */
+#define FMT_PAD_SPACE		' '
+#define FMT_PAD_ZERO		'0'
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: FMT_unsigned
+ *
+ * [Description]: Function to write an unsigned number in decimal
+ *
+ * [Args]:	  Str, value, width, pad
+ *
+ * [in]		  value: Unsigned Long (number to be written)
+ * 		  width: Unsigned Character (minimum number of characters, 0 for none)
+ * 		  pad: Character (FMT_PAD_SPACE or FMT_PAD_ZERO)
+ *
+ * [out]	  Str: Pointer to character (buffer of FMT_BUFFER_SIZE characters)
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     Number of characters written without the null terminator
+ *******************************************************************************/
+uint8 FMT_unsigned(char *Str,uint32 value,uint8 width,char pad);
+
+/*******************************************************************************
+ * [Function Name]: FMT_signed
+ *
+ * [Description]: Function to write a signed number in decimal
+ *
+ * [Args]:	  Str, value, width, pad
+ *
+ * [in]		  value: Signed Long (number to be written)
+ * 		  width: Unsigned Character (minimum number of characters, 0 for none)
+ * 		  pad: Character (FMT_PAD_SPACE or FMT_PAD_ZERO)
+ *
+ * [out]	  Str: Pointer to character (buffer of FMT_BUFFER_SIZE characters)
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     Number of characters written without the null terminator
+ *******************************************************************************/
+uint8 FMT_signed(char *Str,sint32 value,uint8 width,char pad);
+
+/*******************************************************************************
+ * [Function Name]: FMT_fixed
+ *
+ * [Description]: Function to write a fixed point number in decimal, the value
+ * 		  is the number multiplied by 10^decimals (1234 with 2 decimals
+ * 		  is written as 12.34)
+ *
+ * [Args]:	  Str, value, decimals, width, pad
+ *
+ * [in]		  value: Signed Long (scaled number to be written)
+ * 		  decimals: Unsigned Character (digits after the decimal point)
+ * 		  width: Unsigned Character (minimum number of characters, 0 for none)
+ * 		  pad: Character (FMT_PAD_SPACE or FMT_PAD_ZERO)
+ *
+ * [out]	  Str: Pointer to character (buffer of FMT_BUFFER_SIZE characters)
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     Number of characters written without the null terminator
+ *******************************************************************************/
+uint8 FMT_fixed(char *Str,sint32 value,uint8 decimals,uint8 width,char pad);
+
+/*******************************************************************************
+ * [Function Name]: FMT_hex
+ *
+ * [Description]: Function to write a number in upper case hexadecimal
+ *
+ * [Args]:	  Str, value, digits
+ *
+ * [in]		  value: Unsigned Long (number to be written)
+ * 		  digits: Unsigned Character (number of hex digits 1 --> 8)
+ *
+ * [out]	  Str: Pointer to character (buffer of FMT_BUFFER_SIZE characters)
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     Number of characters written without the null terminator
+ *******************************************************************************/
+uint8 FMT_hex(char *Str,uint32 value,uint8 digits);
+
+#endif /* FMT_H_ */
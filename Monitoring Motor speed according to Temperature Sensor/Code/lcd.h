@@ -16,36 +16,87 @@
 #include "std_types.h"
 #include "common_macros.h"
 #include "micro_config.h"
+#include "fmt.h"
+#include <avr/pgmspace.h>
 
 /*******************************************************************************
  *                      Preprocessor Macros                                    *
  *******************************************************************************/
-/* LCD HW Pins */
-#define RS PD4
-#define RW PD5
-#define E  PD6
-#define LCD_CTRL_PORT PORTD
-#define LCD_CTRL_PORT_DIR DDRD
-#define LCD_DATA_PORT PORTC
-#define LCD_DATA_PORT_DIR DDRC
+/*
+ * LCD Timing modes:
+ * BUSY_FLAG_TIMING : Read the busy flag back through the data port before each transfer
+ * DELAY_TIMING     : Wait the datasheet execution time of each instruction instead
+ */
+#define BUSY_FLAG_TIMING 1
+#define DELAY_TIMING     2
+
+/* Project configuration: geometry, data bits mode, timing mode and HW pins */
+#include "lcd_config.h"
+
+#if (DATA_BITS_MODE != 4) && (DATA_BITS_MODE != 8)
+#error "DATA_BITS_MODE must be 4 or 8"
+#endif
+
+#if ((LCD_ROWS != 2) && (LCD_ROWS != 4)) || ((LCD_COLUMNS != 16) && (LCD_COLUMNS != 20))
+#error "Supported LCD geometries are 2 * 16, 2 * 20, 4 * 16 and 4 * 20"
+#endif
+
+#if (LCD_TIMING_MODE != BUSY_FLAG_TIMING) && (LCD_TIMING_MODE != DELAY_TIMING)
+#error "LCD_TIMING_MODE must be BUSY_FLAG_TIMING or DELAY_TIMING"
+#endif
+
+/*
+ * DDRAM address of the first column of each row, rows 2 and 3 of a 4 lines LCD
+ * continue rows 0 and 1 after the last visible column
+ */
+#define LCD_ROW0_ADDRESS 0x00
+#define LCD_ROW1_ADDRESS 0x40
+#define LCD_ROW2_ADDRESS (LCD_ROW0_ADDRESS + LCD_COLUMNS)
+#define LCD_ROW3_ADDRESS (LCD_ROW1_ADDRESS + LCD_COLUMNS)
 
 /* LCD Commands */
 #define CLEAR_COMMAND 0x01
+#define FOUR_BITS_DATA_MODE 0x02
+#define TWO_LINE_LCD_Four_BIT_MODE 0x28
 #define TWO_LINE_LCD_Eight_BIT_MODE 0x38
 #define CURSOR_OFF 0x0C
 #define CURSOR_ON 0x0E
 #define SET_CURSOR_LOCATION 0x80 
+#define SET_CGRAM_ADDRESS 0x40
+#define EIGHT_BITS_RESET_MODE 0x30 /* Function set used by the initialization by instruction sequence */
+
+/* CGRAM holds 8 user defined characters (codes 0 --> 7) of 8 bytes each */
+#define LCD_CGRAM_CHARACTERS 8
+#define LCD_CGRAM_PATTERN_SIZE 8
+
+/* LCD Busy flag is the MSB of the status byte, the rest is the address counter */
+#define BUSY_FLAG 7
+#define ADDRESS_COUNTER_MASK 0x7F
+
+/* LCD Execution times (HD44780 datasheet at fosc = 270 KHz) */
+#define LCD_POWER_ON_TIME 40     /* ms, wait for Vcc to rise before the first instruction */
+#define LCD_RESET_TIME 4100      /* us, wait after the first function set of the reset sequence */
+#define LCD_CLEAR_HOME_TIME 1520 /* us, clear display and return home instructions */
+#define LCD_EXECUTION_TIME 43    /* us, all other instructions and data writes (37us + tADD 4us) */
 
 /*******************************************************************************
  *                      Functions Prototypes                                   *
  *******************************************************************************/
 void LCD_sendCommand(uint8 command);
 void LCD_displayCharacter(uint8 data);
+void LCD_writeCommand(uint8 command);
+void LCD_writeData(uint8 data);
 void LCD_displayString(const char *Str);
 void LCD_init(void);
 void LCD_clearScreen(void);
 void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str);
+void LCD_displayString_P(const char *Str);
+void LCD_displayStringRowColumn_P(uint8 row,uint8 col,const char *Str);
 void LCD_goToRowColumn(uint8 row,uint8 col);
+uint8 LCD_getRowColumnAddress(uint8 row,uint8 col);
+void LCD_setCgramPattern_P(uint8 slot,const uint8 *pattern);
 void LCD_intgerToString(int data);
+uint8 LCD_getAddressCounter(void);
+uint8 LCD_isBusy(void);
 
 #endif /* LCD_H_ */
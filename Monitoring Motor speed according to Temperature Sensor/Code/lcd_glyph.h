@@ -0,0 +1,133 @@
+ /******************************************************************************
+ *
+ * [MODULE]: LCD GLYPH
+ *
+ * [FILE NAME]: lcd_glyph.h
+ *
+ * [DESCRIPTION]: Header file for the LCD custom characters manager, the 8 CGRAM
+ * 		  characters are used as a cache of glyph patterns stored in the
+ * 		  flash, a pattern is uploaded only when it is not already in the
+ * 		  CGRAM and the least recently used one is replaced, it also
+ * 		  draws big digits over 2 rows built from these glyphs
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef LCD_GLYPH_H_
+#define LCD_GLYPH_H_
+
+#include "std_types.h"
+#include "lcd.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/*
+ * Output of the glyph manager is selected in lcd_config.h:
+ * LCD_GLYPH_USE_QUEUE defined   : write through the LCD queue (lcd_queue.c)
+ * LCD_GLYPH_USE_QUEUE undefined : write directly through the LCD driver
+ */
+
+/* Code returned when the glyph can not be loaded (all the slots are used in the current frame) */
+#define LCD_GLYPH_FALLBACK	'#'
+
+/* Size of a big character: 3 columns * 2 rows, a blank column separates two big characters */
+#define LCD_GLYPH_BIG_WIDTH	3
+#define LCD_GLYPH_BIG_HEIGHT	2
+
+/*
+ * Queue entries taken by one LCD_GLYPH_displayBigString in the worst case: a cursor move
+ * and LCD_COLUMNS characters per row, and the upload (address + 8 bytes) of the 3 glyphs
+ * of the big font (61 entries on a 16 columns LCD)
+ */
+#define LCD_GLYPH_BIG_MAX_ENTRIES	((LCD_GLYPH_BIG_HEIGHT * (1 + LCD_COLUMNS)) + \
+					 (3 * (1 + LCD_CGRAM_PATTERN_SIZE)))
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: LCD_GLYPH_init
+ *
+ * [Description]: Function to mark all the CGRAM slots as empty
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_GLYPH_init(void);
+
+/*******************************************************************************
+ * [Function Name]: LCD_GLYPH_newFrame
+ *
+ * [Description]: Function to start a new redraw of the screen, the glyphs got
+ * 		  after this call can not be replaced until the next call, so a
+ * 		  glyph still shown on the screen is never overwritten
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_GLYPH_newFrame(void);
+
+/*******************************************************************************
+ * [Function Name]: LCD_GLYPH_get
+ *
+ * [Description]: Function to get the character code of a glyph, the pattern is
+ * 		  uploaded to the CGRAM only if it is not already there, after
+ * 		  an upload the LCD cursor is in the CGRAM so the cursor must be
+ * 		  set again before writing characters
+ *
+ * [Args]:	  pattern
+ *
+ * [in]		  pattern: Pointer to Unsigned Character (LCD_CGRAM_PATTERN_SIZE
+ * 			   bytes in the flash, it also identifies the glyph)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     Character code 0 --> 7, or LCD_GLYPH_FALLBACK if no slot is free
+ *******************************************************************************/
+uint8 LCD_GLYPH_get(const uint8 *pattern);
+
+/*******************************************************************************
+ * [Function Name]: LCD_GLYPH_displayBigString
+ *
+ * [Description]: Function to display digits, '-', '.' and ' ' in big characters
+ * 		  over the rows (row) and (row + 1), other characters are blank.
+ * 		  With LCD_GLYPH_USE_QUEUE the queue must have
+ * 		  LCD_GLYPH_BIG_MAX_ENTRIES free entries before the call (wait
+ * 		  for LCD_QUEUE_isFlushDone or LCD_QUEUE_waitFreeEntries), an
+ * 		  entry that does not fit is dropped and 0 is returned
+ *
+ * [Args]:	  row, col, Str
+ *
+ * [in]		  row: Unsigned Character (upper row of the big characters)
+ * 		  col: Unsigned Character (first column)
+ * 		  Str: Pointer to Character (string to be displayed)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     Number of columns used, or 0 if a part of the output was dropped
+ *******************************************************************************/
+uint8 LCD_GLYPH_displayBigString(uint8 row,uint8 col,const char *Str);
+
+#endif /* LCD_GLYPH_H_ */
@@ -0,0 +1,239 @@
+ /******************************************************************************
+ *
+ * [MODULE]: LCD QUEUE
+ *
+ * [FILE NAME]: lcd_queue.h
+ *
+ * [DESCRIPTION]: Header file for the non-blocking LCD output queue, commands and
+ * 		  characters are stored in a bounded queue and sent to the LCD
+ * 		  from the TIMER2 compare match interrupt at the LCD pace
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef LCD_QUEUE_H_
+#define LCD_QUEUE_H_
+
+#include "micro_config.h"
+#include "std_types.h"
+#include "common_macros.h"
+#include "lcd.h"
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+
+/* Number of entries in the queue (must be a power of 2 and not more than 128) */
+#define LCD_QUEUE_SIZE		64
+#define LCD_QUEUE_MASK		(LCD_QUEUE_SIZE - 1)
+
+/*
+ * Period of the service tick in micro-seconds, TIMER2 runs with F_CPU/8 in CTC
+ * mode, so the tick must be at least 8 and not more than 2048 clock cycles. The
+ * tick interrupt is enabled by each new entry and disabled once the queue is
+ * empty and the LCD executed the last entry
+ */
+#define LCD_QUEUE_TICK_TIME	250
+#define LCD_QUEUE_TICK_COMPARE	((((F_CPU / 1000000UL) * LCD_QUEUE_TICK_TIME) / 8) - 1)
+
+/*
+ * Maximum number of entries sent to the LCD in one tick to bound the ISR time, the
+ * ISR never waits for the LCD: with BUSY_FLAG_TIMING it stops at the first busy read,
+ * with DELAY_TIMING it sends one entry and skips the ticks of its execution time
+ */
+#define LCD_QUEUE_TICK_BURST	4
+
+/* Ticks covering an execution time in micro-seconds (rounded up, 1 tick at least) */
+#define LCD_QUEUE_TICKS(time)	(((time) + LCD_QUEUE_TICK_TIME - 1) / LCD_QUEUE_TICK_TIME)
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_init
+ *
+ * [Description]: Function to empty the queue and start the TIMER2 service tick
+ * 		  (LCD must be initialized before), after this call all the
+ * 		  LCD output must go through the queue functions
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_QUEUE_init(void);
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_sendCommand
+ *
+ * [Description]: Function to add an LCD instruction to the queue
+ *
+ * [Args]:	  command
+ *
+ * [in]		  command: Unsigned Character (LCD instruction)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the instruction is queued, FALSE if the queue is full
+ *******************************************************************************/
+uint8 LCD_QUEUE_sendCommand(uint8 command);
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_displayCharacter
+ *
+ * [Description]: Function to add a character to the queue
+ *
+ * [Args]:	  data
+ *
+ * [in]		  data: Unsigned Character (character to be displayed)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the character is queued, FALSE if the queue is full
+ *******************************************************************************/
+uint8 LCD_QUEUE_displayCharacter(uint8 data);
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_displayString
+ *
+ * [Description]: Function to add a whole string to the queue, nothing is queued
+ * 		  if the string does not fit in the free entries, so the caller
+ * 		  must check the result (or call LCD_QUEUE_waitFreeEntries
+ * 		  before) or the string is lost
+ *
+ * [Args]:	  Str
+ *
+ * [in]		  Str: Pointer to character (string to be displayed)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the string is queued, FALSE if the queue is full
+ *******************************************************************************/
+uint8 LCD_QUEUE_displayString(const char *Str);
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_goToRowColumn
+ *
+ * [Description]: Function to add a cursor move to the queue
+ *
+ * [Args]:	  row, col
+ *
+ * [in]		  row: Unsigned Character (required row)
+ * 		  col: Unsigned Character (required column)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the cursor move is queued, FALSE if the queue is full
+ *******************************************************************************/
+uint8 LCD_QUEUE_goToRowColumn(uint8 row,uint8 col);
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_displayStringRowColumn
+ *
+ * [Description]: Function to add a cursor move followed by a string to the
+ * 		  queue, nothing is queued if both of them do not fit, so the
+ * 		  caller must check the result (or call LCD_QUEUE_waitFreeEntries
+ * 		  before) or the output is lost
+ *
+ * [Args]:	  row, col, Str
+ *
+ * [in]		  row: Unsigned Character (row of the first character)
+ * 		  col: Unsigned Character (column of the first character)
+ * 		  Str: Pointer to character (string to be displayed)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the output is queued, FALSE if the queue is full
+ *******************************************************************************/
+uint8 LCD_QUEUE_displayStringRowColumn(uint8 row,uint8 col,const char *Str);
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_intgerToString
+ *
+ * [Description]: Function to add the decimal digits of an integer to the queue
+ *
+ * [Args]:	  data
+ *
+ * [in]		  data: Integer (number to be displayed)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the number is queued, FALSE if the queue is full
+ *******************************************************************************/
+uint8 LCD_QUEUE_intgerToString(int data);
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_clearScreen
+ *
+ * [Description]: Function to add the clear display instruction to the queue
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the instruction is queued, FALSE if the queue is full
+ *******************************************************************************/
+uint8 LCD_QUEUE_clearScreen(void);
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_isFlushDone
+ *
+ * [Description]: Function to check if all the queued output reached the LCD
+ *
+ * [Args]:	  None
+ *
+ * [in]		  None
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     TRUE if the queue is empty, FALSE otherwise
+ *******************************************************************************/
+uint8 LCD_QUEUE_isFlushDone(void);
+
+/*******************************************************************************
+ * [Function Name]: LCD_QUEUE_waitFreeEntries
+ *
+ * [Description]: Function to wait until the ISR sent enough entries to the LCD
+ * 		  for the next output to be queued, it must not be called with
+ * 		  the interrupts disabled (the queue would never be emptied)
+ *
+ * [Args]:	  count
+ *
+ * [in]		  count: Unsigned Character (entries needed, a cursor move and
+ * 			 each character take one entry, not more than
+ * 			 LCD_QUEUE_SIZE - 1)
+ *
+ * [out]	  None
+ *
+ * [in/out]	  None
+ *
+ * [Returns]:     None
+ *******************************************************************************/
+void LCD_QUEUE_waitFreeEntries(uint8 count);
+
+#endif /* LCD_QUEUE_H_ */
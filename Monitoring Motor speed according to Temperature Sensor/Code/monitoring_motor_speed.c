@@ -12,7 +12,7 @@
  * 			Design Considerations:
  *
  * 			- MCU : ATmega 16 (F_CPU = 1 MHZ).
- *			- Display Temperature degree on LCD (2 * 16) in PORTC.
+ *			- Display Temperature degree on LCD (2 * 16) in PORTC in big digits.
  *			- Control Motor speed using PWM [TIMER CTC Mode].
  *			- Use SW connected in (Pin3) in PORTD to revert the Motor Direction[INT0].
  *			- Sensor is connected through the ADC Driver, then Display the result on
@@ -25,6 +25,9 @@
 #include "common_macros.h"
 #include "adc.h"
 #include "lcd.h"
+#include "lcd_queue.h"
+#include "lcd_glyph.h"
+#include "fmt.h"
 #include "dc_motor.h"
 #include "interrupt.h"
 
@@ -39,6 +42,8 @@ int main(void)
 	 ********************************************************************************/
 
 	uint16 res_value;	/* Global variable to store ADC register value in it */
+	uint16 shown_value = 0xFFFF;	/* Value on the LCD (none at the beginning) */
+	char buff[FMT_BUFFER_SIZE];
 
 	/*
 	 * Set PB3/OC0 as output pin --> pin where the PWM signal is generated from MC.
@@ -55,10 +60,11 @@ int main(void)
 
 	INT1_init(); /* Initialize interrupt driver */
 	LCD_init();  /* Initialize LCD driver */
+	LCD_QUEUE_init(); /* Initialize LCD output queue */
+	LCD_GLYPH_init(); /* Initialize LCD custom characters */
 	ADC_init();  /* Initialize ADC driver */
 
-	LCD_clearScreen(); /* Clear LCD at the beginning */
-	LCD_displayString("ADC Value = ");	/* Display this string "ADC Value = " only once at LCD */
+	LCD_QUEUE_clearScreen(); /* Clear LCD at the beginning */
 
 	/********************************************************************************
 	 *                        APPLICATION	(SUPER LOOP)	         	        *
@@ -66,9 +72,20 @@ int main(void)
 
 	while(1)
 	{
-		LCD_goToRowColumn(0,12); 	/* Display the number every time at this position */
 		res_value = ADC_readChannel(0); /* Read channel zero where the potentiometer is connect */
-		LCD_intgerToString(res_value); 	/* Display the ADC value on LCD screen */
+
+		/*
+		 * Queue a new reading only after the previous one reached the LCD and only if it
+		 * changed, the ADC value is shown in big digits over the 2 rows, padded to 4 digits
+		 * so the old digits are always overwritten (the glyphs are uploaded only once)
+		 */
+		if(LCD_QUEUE_isFlushDone() && (res_value != shown_value))
+		{
+			shown_value = res_value;
+			LCD_GLYPH_newFrame();
+			FMT_unsigned(buff, res_value, 4, FMT_PAD_SPACE);
+			LCD_GLYPH_displayBigString(0, 0, buff);
+		}
 
 
 		if(res_value > ZERO_TEMP && res_value <= LOW_TEMP)
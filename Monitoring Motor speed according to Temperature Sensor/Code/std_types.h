@@ -24,6 +24,8 @@ typedef unsigned char bool;
 #define TRUE        (1u)
 #endif
 
+#define NULL_PTR    ((void*)0)
+
 #define HIGH        (1u)
 #define LOW         (0u)
 
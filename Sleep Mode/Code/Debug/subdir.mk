@@ -4,14 +4,17 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../fmt.c \
 ../lcd.c \
 ../sleep_mode.c 
 
 OBJS += \
+./fmt.o \
 ./lcd.o \
 ./sleep_mode.o 
 
 C_DEPS += \
+./fmt.d \
 ./lcd.d \
 ./sleep_mode.d 
 
@@ -12,47 +12,251 @@
 
 #include "lcd.h"
 
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* DDRAM address of the first column of each row */
+#if (LCD_ROWS == 2)
+static const uint8 g_rowAddress[LCD_ROWS] = {LCD_ROW0_ADDRESS, LCD_ROW1_ADDRESS};
+#elif (LCD_ROWS == 4)
+static const uint8 g_rowAddress[LCD_ROWS] = {LCD_ROW0_ADDRESS, LCD_ROW1_ADDRESS, LCD_ROW2_ADDRESS, LCD_ROW3_ADDRESS};
+#endif
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for waiting until the LCD is ready to accept the next
+ * instruction, by polling the busy flag or by doing nothing in delay mode
+ */
+static void LCD_waitReady(void);
+
+/*
+ * Function responsible for writing one byte to the LCD, RS must be set before
+ */
+static void LCD_writeByte(uint8 data);
+
+/*
+ * Function responsible for reading one byte from the LCD, RS must be set before
+ */
+static uint8 LCD_readByte(void);
+
+#if (DATA_BITS_MODE == 4)
+/*
+ * Function responsible for writing the lowest 4 bits of data to the data bus D4 --> D7
+ */
+static void LCD_writeNibble(uint8 nibble);
+
+/*
+ * Function responsible for reading 4 bits from the data bus D4 --> D7
+ */
+static uint8 LCD_readNibble(void);
+#endif
+
 /*******************************************************************************
  *                      Functions Definitions                                  *
  *******************************************************************************/
 void LCD_init(void)
 {
-	LCD_DATA_PORT_DIR = 0xFF; /* Configure the data port as output port */ 
 	LCD_CTRL_PORT_DIR |= (1<<E) | (1<<RS) | (1<<RW); /* Configure the control pins(E,RS,RW) as output pins */
-	
-	LCD_sendCommand(TWO_LINE_LCD_Eight_BIT_MODE); /* Use 2-line lcd + 8-bit Data Mode + 5*7 dot display Mode */
-	
+	CLEAR_BIT(LCD_CTRL_PORT,E); /* Disable LCD E=0 */
+	CLEAR_BIT(LCD_CTRL_PORT,RS); /* Instruction Mode RS=0 */
+
+	_delay_ms(LCD_POWER_ON_TIME); /* Wait for the LCD internal reset after power on */
+
+	/*
+	 * Initialization by instruction: the LCD may be in any mode, so send the 8-bit function
+	 * set three times before selecting the required mode, the busy flag can not be checked
+	 * during this sequence
+	 */
+	#if (DATA_BITS_MODE == 4)
+		#ifdef UPPER_PORT_PINS
+			LCD_DATA_PORT_DIR |= 0xF0; /* Configure the highest 4 bits of the data port as output pins */
+		#else
+			LCD_DATA_PORT_DIR |= 0x0F; /* Configure the lowest 4 bits of the data port as output pins */
+		#endif
+		CLEAR_BIT(LCD_CTRL_PORT,RW); /* Write data to LCD so RW=0 */
+		LCD_writeNibble(EIGHT_BITS_RESET_MODE >> 4);
+		_delay_us(LCD_RESET_TIME);
+		LCD_writeNibble(EIGHT_BITS_RESET_MODE >> 4);
+		_delay_us(LCD_EXECUTION_TIME);
+		LCD_writeNibble(EIGHT_BITS_RESET_MODE >> 4);
+		_delay_us(LCD_EXECUTION_TIME);
+		LCD_writeNibble(FOUR_BITS_DATA_MODE); /* Initialize LCD in 4-bit mode */
+		_delay_us(LCD_EXECUTION_TIME);
+		LCD_sendCommand(TWO_LINE_LCD_Four_BIT_MODE); /* Use 2-line lcd + 4-bit Data Mode + 5*7 dot display Mode */
+	#elif (DATA_BITS_MODE == 8)
+		LCD_DATA_PORT_DIR = 0xFF; /* Configure the data port as output port */
+		LCD_writeByte(EIGHT_BITS_RESET_MODE);
+		_delay_us(LCD_RESET_TIME);
+		LCD_writeByte(EIGHT_BITS_RESET_MODE);
+		_delay_us(LCD_EXECUTION_TIME);
+		LCD_writeByte(EIGHT_BITS_RESET_MODE);
+		_delay_us(LCD_EXECUTION_TIME);
+		LCD_sendCommand(TWO_LINE_LCD_Eight_BIT_MODE); /* Use 2-line lcd + 8-bit Data Mode + 5*7 dot display Mode */
+	#endif
+
 	LCD_sendCommand(CURSOR_OFF); /* Cursor off */
-	
 	LCD_sendCommand(CLEAR_COMMAND); /* Clear LCD at the beginning */
 }
 
 void LCD_sendCommand(uint8 command)
 {
-	CLEAR_BIT(LCD_CTRL_PORT,RS); /* Instruction Mode RS = 0 */
-	CLEAR_BIT(LCD_CTRL_PORT,RW); /* Write data to LCD so RW = 0 */
-	_delay_ms(1); /* Delay for processing Tas = 50ns */
-	SET_BIT(LCD_CTRL_PORT,E); /* Enable LCD E = 1 */
-	_delay_ms(1); /* Delay for processing Tpw - Tdws = 190ns */
-	LCD_DATA_PORT = command; /* Out the required command to the data bus D0 --> D7 */
-	_delay_ms(1); /* Delay for processing Tdsw = 100ns */
-	CLEAR_BIT(LCD_CTRL_PORT,E); /* Disable LCD E = 0 */
-	_delay_ms(1); /* Delay for processing Th = 13ns */
+	LCD_waitReady(); /* Wait until the LCD finishes the previous instruction */
+	LCD_writeCommand(command);
+
+#if (LCD_TIMING_MODE == DELAY_TIMING)
+	/* Clear display (0x01) and return home (0x02, 0x03) are the only long instructions */
+	if(command <= 0x03)
+	{
+		_delay_us(LCD_CLEAR_HOME_TIME);
+	}
+	else
+	{
+		_delay_us(LCD_EXECUTION_TIME);
+	}
+#endif
 }
 
 void LCD_displayCharacter(uint8 data)
 {
-	SET_BIT(LCD_CTRL_PORT,RS); /* Data Mode RS = 1 */
-	CLEAR_BIT(LCD_CTRL_PORT,RW); /* Write data to LCD so RW = 0 */
-	_delay_ms(1); /* Delay for processing Tas = 50ns */
-	SET_BIT(LCD_CTRL_PORT,E); /* Enable LCD E = 1 */
-	_delay_ms(1); /* Delay for processing Tpw - Tdws = 190ns */
-	LCD_DATA_PORT = data; /* Out the required data char to the data bus D0 --> D7 */
-	_delay_ms(1); /* Delay for processing Tdsw = 100ns */
-	CLEAR_BIT(LCD_CTRL_PORT,E); /* disable LCD E = 0 */
-	_delay_ms(1); /* Delay for processing Th = 13ns */	
+	LCD_waitReady(); /* Wait until the LCD finishes the previous instruction */
+	LCD_writeData(data);
+
+#if (LCD_TIMING_MODE == DELAY_TIMING)
+	_delay_us(LCD_EXECUTION_TIME);
+#endif
+}
+
+/*
+ * Raw transfers without any wait, the caller must know the LCD is ready (busy flag read
+ * as cleared, or the execution time of the previous instruction elapsed), they are used
+ * by an interrupt that schedules the LCD itself (lcd_queue)
+ */
+void LCD_writeCommand(uint8 command)
+{
+	CLEAR_BIT(LCD_CTRL_PORT,RS); /* Instruction Mode RS=0 */
+	LCD_writeByte(command);
 }
 
+void LCD_writeData(uint8 data)
+{
+	SET_BIT(LCD_CTRL_PORT,RS); /* Data Mode RS=1 */
+	LCD_writeByte(data);
+}
+
+uint8 LCD_getAddressCounter(void)
+{
+	LCD_waitReady(); /* The address counter is valid only when the LCD is not busy */
+	CLEAR_BIT(LCD_CTRL_PORT,RS); /* Read busy flag and address counter RS=0 */
+	return (LCD_readByte() & ADDRESS_COUNTER_MASK);
+}
+
+uint8 LCD_isBusy(void)
+{
+#if (LCD_TIMING_MODE == BUSY_FLAG_TIMING)
+	CLEAR_BIT(LCD_CTRL_PORT,RS); /* Read busy flag and address counter RS=0 */
+	if(BIT_IS_SET(LCD_readByte(),BUSY_FLAG))
+	{
+		return TRUE;
+	}
+#endif
+	return FALSE; /* In delay mode each transfer already waits its own execution time */
+}
+
+static void LCD_waitReady(void)
+{
+#if (LCD_TIMING_MODE == BUSY_FLAG_TIMING)
+	CLEAR_BIT(LCD_CTRL_PORT,RS); /* Read busy flag and address counter RS=0 */
+	while(BIT_IS_SET(LCD_readByte(),BUSY_FLAG)); /* Wait until the busy flag is cleared */
+#endif
+}
+
+static void LCD_writeByte(uint8 data)
+{
+	CLEAR_BIT(LCD_CTRL_PORT,RW); /* Write data to LCD so RW=0 */
+	_delay_us(1); /* Delay for processing Tas = 50ns */
+#if (DATA_BITS_MODE == 4)
+	LCD_writeNibble(data >> 4); /* Out the highest 4 bits of the required data */
+	LCD_writeNibble(data); /* Out the lowest 4 bits of the required data */
+#elif (DATA_BITS_MODE == 8)
+	SET_BIT(LCD_CTRL_PORT,E); /* Enable LCD E=1 */
+	LCD_DATA_PORT = data; /* Out the required data to the data bus D0 --> D7 */
+	_delay_us(1); /* Delay for processing Tpw = 230ns */
+	CLEAR_BIT(LCD_CTRL_PORT,E); /* Disable LCD E=0 */
+	_delay_us(1); /* Delay for processing Th = 10ns and Tcyce = 500ns */
+#endif
+}
+
+static uint8 LCD_readByte(void)
+{
+	uint8 data;
+
+#if (DATA_BITS_MODE == 4)
+	#ifdef UPPER_PORT_PINS
+		LCD_DATA_PORT_DIR &= 0x0F; /* Configure the highest 4 bits of the data port as input pins */
+	#else
+		LCD_DATA_PORT_DIR &= 0xF0; /* Configure the lowest 4 bits of the data port as input pins */
+	#endif
+	SET_BIT(LCD_CTRL_PORT,RW); /* Read data from LCD so RW=1 */
+	_delay_us(1); /* Delay for processing Tas = 50ns */
+	data = LCD_readNibble() << 4; /* Read the highest 4 bits first */
+	data |= LCD_readNibble(); /* Then the lowest 4 bits */
+	CLEAR_BIT(LCD_CTRL_PORT,RW); /* Return the bus to write direction */
+	#ifdef UPPER_PORT_PINS
+		LCD_DATA_PORT_DIR |= 0xF0; /* Configure the highest 4 bits of the data port as output pins */
+	#else
+		LCD_DATA_PORT_DIR |= 0x0F; /* Configure the lowest 4 bits of the data port as output pins */
+	#endif
+#elif (DATA_BITS_MODE == 8)
+	LCD_DATA_PORT_DIR = 0x00; /* Configure the data port as input port */
+	SET_BIT(LCD_CTRL_PORT,RW); /* Read data from LCD so RW=1 */
+	_delay_us(1); /* Delay for processing Tas = 50ns */
+	SET_BIT(LCD_CTRL_PORT,E); /* Enable LCD E=1 */
+	_delay_us(1); /* Delay for processing Tddr = 160ns */
+	data = LCD_DATA_PORT_IN; /* Read the data bus D0 --> D7 */
+	CLEAR_BIT(LCD_CTRL_PORT,E); /* Disable LCD E=0 */
+	_delay_us(1); /* Delay for processing Th = 10ns and Tcyce = 500ns */
+	CLEAR_BIT(LCD_CTRL_PORT,RW); /* Return the bus to write direction */
+	LCD_DATA_PORT_DIR = 0xFF; /* Configure the data port as output port */
+#endif
+
+	return data;
+}
+
+#if (DATA_BITS_MODE == 4)
+static void LCD_writeNibble(uint8 nibble)
+{
+	SET_BIT(LCD_CTRL_PORT,E); /* Enable LCD E=1 */
+#ifdef UPPER_PORT_PINS
+	LCD_DATA_PORT = (LCD_DATA_PORT & 0x0F) | ((nibble & 0x0F) << 4);
+#else
+	LCD_DATA_PORT = (LCD_DATA_PORT & 0xF0) | (nibble & 0x0F);
+#endif
+	_delay_us(1); /* Delay for processing Tpw = 230ns */
+	CLEAR_BIT(LCD_CTRL_PORT,E); /* Disable LCD E=0 */
+	_delay_us(1); /* Delay for processing Th = 10ns and Tcyce = 500ns */
+}
+
+static uint8 LCD_readNibble(void)
+{
+	uint8 nibble;
+
+	SET_BIT(LCD_CTRL_PORT,E); /* Enable LCD E=1 */
+	_delay_us(1); /* Delay for processing Tddr = 160ns */
+#ifdef UPPER_PORT_PINS
+	nibble = (LCD_DATA_PORT_IN >> 4);
+#else
+	nibble = (LCD_DATA_PORT_IN & 0x0F);
+#endif
+	CLEAR_BIT(LCD_CTRL_PORT,E); /* Disable LCD E=0 */
+	_delay_us(1); /* Delay for processing Th = 10ns and Tcyce = 500ns */
+	return nibble;
+}
+#endif
+
 void LCD_displayString(const char *Str)
 {
 	uint8 i = 0;
@@ -63,31 +267,17 @@ void LCD_displayString(const char *Str)
 	}
 }
 
+uint8 LCD_getRowColumnAddress(uint8 row,uint8 col)
+{
+	/* The row number wraps around the number of rows, so any row gives a valid address */
+	return g_rowAddress[row & (LCD_ROWS - 1)] + col;
+}
+
 void LCD_goToRowColumn(uint8 row,uint8 col)
 {
-	uint8 Address;
-	
-	/* First of all calculate the required address */
-	switch(row)
-	{
-		case 0:
-			Address=col;
-			break;
-		case 1:
-			Address=col+0x40;
-			break;
-		case 2:
-			Address=col+0x10;
-			break;
-		case 3:
-			Address=col+0x50;
-			break;
-	}					
-	/* 
-	 * To write to a specific address in the LCD 
-	 * we need to apply the corresponding command 0b10000000+Address 
-	 */
-	LCD_sendCommand(Address | SET_CURSOR_LOCATION); 
+	/* To write to a specific address in the LCD
+	 * we need to apply the corresponding command 0b10000000+Address */
+	LCD_sendCommand(LCD_getRowColumnAddress(row,col) | SET_CURSOR_LOCATION);
 }
 
 void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str)
@@ -96,10 +286,40 @@ void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str)
 	LCD_displayString(Str); /* Display the string */
 }
 
+void LCD_displayString_P(const char *Str)
+{
+	uint8 data;
+
+	/* The string is stored in the flash, so read it byte by byte through the LPM instruction */
+	while((data = pgm_read_byte(Str)) != '\0')
+	{
+		LCD_displayCharacter(data);
+		Str++;
+	}
+}
+
+void LCD_displayStringRowColumn_P(uint8 row,uint8 col,const char *Str)
+{
+	LCD_goToRowColumn(row,col); /* Go to to the required LCD position */
+	LCD_displayString_P(Str); /* Display the flash string */
+}
+
+void LCD_setCgramPattern_P(uint8 slot,const uint8 *pattern)
+{
+	uint8 i;
+
+	/* Each of the 8 CGRAM characters takes 8 bytes, one byte per row of 5 pixels */
+	LCD_sendCommand(SET_CGRAM_ADDRESS | ((slot & (LCD_CGRAM_CHARACTERS - 1)) << 3));
+	for(i = 0; i < LCD_CGRAM_PATTERN_SIZE; i++)
+	{
+		LCD_displayCharacter(pgm_read_byte(&pattern[i]));
+	}
+}
+
 void LCD_intgerToString(int data)
 {
-   char buff[16]; /* String to hold the ASCII result */
-   itoa(data,buff,10); /* 10 for decimal */
+   char buff[FMT_BUFFER_SIZE]; /* String to hold the ASCII result */
+   FMT_signed(buff,data,0,FMT_PAD_SPACE); /* Decimal without padding */
    LCD_displayString(buff);
 }
 
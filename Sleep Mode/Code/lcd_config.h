@@ -0,0 +1,43 @@
+/******************************************************************************
+ *
+ * [MODULE]: LCD
+ *
+ * [FILE NAME]: lcd_config.h
+ *
+ * [DESCRIPTION]: Configuration file of the LCD driver for this project, the
+ * 		  driver files (lcd.c, lcd.h) are the same in all the projects
+ *
+ * [AUTHOR]: Ahmed Hassan
+ *
+ *******************************************************************************/
+
+#ifndef LCD_CONFIG_H_
+#define LCD_CONFIG_H_
+
+/*******************************************************************************
+ *                      Preprocessor Macros                                    *
+ *******************************************************************************/
+/* LCD geometry (2 * 20) */
+#define LCD_ROWS 2
+#define LCD_COLUMNS 20
+
+/* LCD Data bits mode configuration (4 or 8) */
+#define DATA_BITS_MODE 8
+
+/* In 4-bit mode: define it to use the higher 4 bits of the data port, otherwise the lower 4 bits are used */
+#undef UPPER_PORT_PINS
+
+/* LCD Timing mode configuration (BUSY_FLAG_TIMING or DELAY_TIMING) */
+#define LCD_TIMING_MODE BUSY_FLAG_TIMING
+
+/* LCD HW Pins */
+#define RS PD0
+#define RW PD1
+#define E  PD2
+#define LCD_CTRL_PORT PORTD
+#define LCD_CTRL_PORT_DIR DDRD
+#define LCD_DATA_PORT PORTC
+#define LCD_DATA_PORT_DIR DDRC
+#define LCD_DATA_PORT_IN PINC
+
+#endif /* LCD_CONFIG_H_ */